@@ -0,0 +1,337 @@
+/*
+ * CentralDirectory.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "CentralDirectory.h"
+
+#include <algorithm>
+
+#define CPPZIP_CENTRAL_HEADER_SIGNATURE            0x02014b50
+#define CPPZIP_END_OF_CENTRAL_DIR_SIGNATURE        0x06054b50
+#define CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIGNATURE  0x06064b50
+#define CPPZIP_ZIP64_END_LOCATOR_SIGNATURE         0x07064b50
+
+#define CPPZIP_CENTRAL_HEADER_SIZE                 46
+#define CPPZIP_END_OF_CENTRAL_DIR_SIZE             22
+#define CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIZE       56
+#define CPPZIP_ZIP64_END_LOCATOR_SIZE              20
+#define CPPZIP_MAX_COMMENT_SIZE                    0xffff
+#define CPPZIP_ZIP64_EXTRA_FIELD_ID                0x0001
+
+namespace cppzip {
+
+namespace {
+
+unsigned long long readValue(const unsigned char* data, size_t numBytes)
+{
+    unsigned long long value = 0;
+    for(size_t i = numBytes; i > 0; --i){
+        value = (value << 8) | data[i - 1];
+    }
+    return value;
+}
+
+void appendValue(std::vector<unsigned char>& data, unsigned long long value, size_t numBytes)
+{
+    for(size_t i = 0; i < numBytes; ++i){
+        data.push_back(static_cast<unsigned char>(value & 0xff));
+        value >>= 8;
+    }
+}
+
+/*
+ * Takes the real values of the fields set to 0xffffffff from the zip64 extra field.
+ */
+void resolveZip64ExtraField(const unsigned char* extra, size_t extraLength,
+                            CentralDirectoryEntry& entry)
+{
+    size_t pos = 0;
+    while(pos + 4 <= extraLength){
+        unsigned int id = static_cast<unsigned int>(readValue(extra + pos, 2));
+        size_t length = static_cast<size_t>(readValue(extra + pos + 2, 2));
+        const unsigned char* data = extra + pos + 4;
+
+        if(pos + 4 + length > extraLength){
+            return;
+        }
+
+        if(id == CPPZIP_ZIP64_EXTRA_FIELD_ID){
+            size_t fieldPos = 0;
+
+            if(entry.uncompressedSize == 0xffffffff && fieldPos + 8 <= length){
+                entry.uncompressedSize = readValue(data + fieldPos, 8);
+                fieldPos += 8;
+            }
+            if(entry.compressedSize == 0xffffffff && fieldPos + 8 <= length){
+                entry.compressedSize = readValue(data + fieldPos, 8);
+                fieldPos += 8;
+            }
+            if(entry.localHeaderOffset == 0xffffffff && fieldPos + 8 <= length){
+                entry.localHeaderOffset = readValue(data + fieldPos, 8);
+            }
+            return;
+        }
+
+        pos += 4 + length;
+    }
+}
+
+bool findEndOfCentralDirectory(const ReadAt& readAt,
+                               unsigned long long fileSize,
+                               unsigned long long& endPosition,
+                               std::vector<unsigned char>& endRecord)
+{
+    if(fileSize < CPPZIP_END_OF_CENTRAL_DIR_SIZE){
+        return false;
+    }
+
+    //the record is at the end, followed only by the comment
+    size_t tailSize = static_cast<size_t>(std::min<unsigned long long>(
+            fileSize, CPPZIP_END_OF_CENTRAL_DIR_SIZE + CPPZIP_MAX_COMMENT_SIZE));
+    unsigned long long tailPosition = fileSize - tailSize;
+
+    std::vector<unsigned char> tail(tailSize);
+    if(! readAt(tailPosition, tail.data(), tail.size())){
+        return false;
+    }
+
+    for(size_t i = tailSize - CPPZIP_END_OF_CENTRAL_DIR_SIZE + 1; i > 0; --i){
+        const unsigned char* record = tail.data() + i - 1;
+
+        if(readValue(record, 4) == CPPZIP_END_OF_CENTRAL_DIR_SIGNATURE){
+            size_t commentLength = static_cast<size_t>(readValue(record + 20, 2));
+            size_t available = tailSize - (i - 1);
+            if(CPPZIP_END_OF_CENTRAL_DIR_SIZE + commentLength > available){
+                continue;
+            }
+
+            endPosition = tailPosition + i - 1;
+            endRecord.assign(record, record + CPPZIP_END_OF_CENTRAL_DIR_SIZE + commentLength);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} //anonymous namespace
+
+CentralDirectoryEntry::CentralDirectoryEntry()
+    : flag(0)
+    , method(0)
+    , crc(0)
+    , compressedSize(0)
+    , uncompressedSize(0)
+    , localHeaderOffset(0)
+{
+
+}
+
+CentralDirectory::CentralDirectory()
+    : numEntries(0)
+    , offset(0)
+    , position(0)
+    , size(0)
+{
+
+}
+
+bool readEndOfCentralDirectory(const ReadAt& readAt,
+                               unsigned long long fileSize,
+                               CentralDirectory& centralDirectory)
+{
+    unsigned long long endPosition = 0;
+    std::vector<unsigned char> endRecord;
+
+    if(! findEndOfCentralDirectory(readAt, fileSize, endPosition, endRecord)){
+        return false;
+    }
+
+    unsigned long long numEntries = readValue(endRecord.data() + 10, 2);
+    unsigned long long size = readValue(endRecord.data() + 12, 4);
+    unsigned long long offset = readValue(endRecord.data() + 16, 4);
+    unsigned long long recordsEnd = endPosition;
+
+    centralDirectory.comment.assign(endRecord.begin() + CPPZIP_END_OF_CENTRAL_DIR_SIZE, endRecord.end());
+
+    //zip64: the locator is right in front of the end record
+    if(endPosition >= CPPZIP_ZIP64_END_LOCATOR_SIZE){
+        unsigned char locator[CPPZIP_ZIP64_END_LOCATOR_SIZE];
+
+        if(readAt(endPosition - CPPZIP_ZIP64_END_LOCATOR_SIZE, locator, sizeof(locator)) &&
+           readValue(locator, 4) == CPPZIP_ZIP64_END_LOCATOR_SIGNATURE)
+        {
+            unsigned long long zip64EndOffset = readValue(locator + 8, 8);
+            unsigned char zip64End[CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIZE];
+
+            //the stored offset can be shifted by data in front of the zip
+            unsigned long long zip64EndPosition = endPosition - CPPZIP_ZIP64_END_LOCATOR_SIZE - sizeof(zip64End);
+            if(! readAt(zip64EndPosition, zip64End, sizeof(zip64End)) ||
+               readValue(zip64End, 4) != CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIGNATURE)
+            {
+                zip64EndPosition = zip64EndOffset;
+                if(! readAt(zip64EndPosition, zip64End, sizeof(zip64End)) ||
+                   readValue(zip64End, 4) != CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIGNATURE)
+                {
+                    return false;
+                }
+            }
+
+            numEntries = readValue(zip64End + 32, 8);
+            size = readValue(zip64End + 40, 8);
+            offset = readValue(zip64End + 48, 8);
+            recordsEnd = zip64EndPosition;
+        }
+    }
+
+    if(size > recordsEnd){
+        return false;
+    }
+
+    centralDirectory.numEntries = numEntries;
+    centralDirectory.offset = offset;
+    centralDirectory.size = size;
+    centralDirectory.position = recordsEnd - size;
+    centralDirectory.endRecord.swap(endRecord);
+
+    return true;
+}
+
+bool readCentralDirectory(const ReadAt& readAt,
+                          unsigned long long fileSize,
+                          CentralDirectory& centralDirectory)
+{
+    if(! readEndOfCentralDirectory(readAt, fileSize, centralDirectory)){
+        return false;
+    }
+
+    unsigned long long numEntries = centralDirectory.numEntries;
+    unsigned long long size = centralDirectory.size;
+
+    //read all records in one piece
+    std::vector<unsigned char> records(static_cast<size_t>(size));
+    if(size > 0 && ! readAt(centralDirectory.position, records.data(), records.size())){
+        return false;
+    }
+
+    centralDirectory.entries.clear();
+    centralDirectory.entries.reserve(static_cast<size_t>(numEntries));
+
+    size_t pos = 0;
+    for(unsigned long long i = 0; i < numEntries; ++i){
+        if(pos + CPPZIP_CENTRAL_HEADER_SIZE > records.size()){
+            return false;
+        }
+
+        const unsigned char* record = records.data() + pos;
+        if(readValue(record, 4) != CPPZIP_CENTRAL_HEADER_SIGNATURE){
+            return false;
+        }
+
+        size_t fileNameLength = static_cast<size_t>(readValue(record + 28, 2));
+        size_t extraLength = static_cast<size_t>(readValue(record + 30, 2));
+        size_t commentLength = static_cast<size_t>(readValue(record + 32, 2));
+        size_t recordSize = CPPZIP_CENTRAL_HEADER_SIZE + fileNameLength + extraLength + commentLength;
+
+        if(pos + recordSize > records.size()){
+            return false;
+        }
+
+        CentralDirectoryEntry entry;
+        entry.flag = static_cast<unsigned int>(readValue(record + 8, 2));
+        entry.method = static_cast<unsigned int>(readValue(record + 10, 2));
+        entry.crc = static_cast<unsigned long>(readValue(record + 16, 4));
+        entry.compressedSize = readValue(record + 20, 4);
+        entry.uncompressedSize = readValue(record + 24, 4);
+        entry.localHeaderOffset = readValue(record + 42, 4);
+        entry.fileName.assign(reinterpret_cast<const char*>(record + CPPZIP_CENTRAL_HEADER_SIZE), fileNameLength);
+        entry.record.assign(record, record + recordSize);
+
+        resolveZip64ExtraField(record + CPPZIP_CENTRAL_HEADER_SIZE + fileNameLength, extraLength, entry);
+
+        centralDirectory.entries.push_back(entry);
+        pos += recordSize;
+    }
+
+    return true;
+}
+
+std::vector<unsigned char> buildCentralDirectory(
+        const std::vector<const CentralDirectoryEntry*>& entries,
+        unsigned long long offset,
+        const std::string& comment)
+{
+    std::vector<unsigned char> data;
+
+    for(const auto entry : entries){
+        data.insert(data.end(), entry->record.begin(), entry->record.end());
+    }
+
+    unsigned long long size = data.size();
+    unsigned long long numEntries = entries.size();
+    bool zip64 = numEntries >= 0xffff || size >= 0xffffffff || offset >= 0xffffffff;
+
+    if(zip64){
+        unsigned long long zip64EndOffset = offset + size;
+
+        appendValue(data, CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIGNATURE, 4);
+        appendValue(data, CPPZIP_ZIP64_END_OF_CENTRAL_DIR_SIZE - 12, 8);
+        appendValue(data, 45, 2);             //version made by
+        appendValue(data, 45, 2);             //version needed to extract
+        appendValue(data, 0, 4);              //number of this disk
+        appendValue(data, 0, 4);              //disk with the central directory
+        appendValue(data, numEntries, 8);
+        appendValue(data, numEntries, 8);
+        appendValue(data, size, 8);
+        appendValue(data, offset, 8);
+
+        appendValue(data, CPPZIP_ZIP64_END_LOCATOR_SIGNATURE, 4);
+        appendValue(data, 0, 4);              //disk with the zip64 end record
+        appendValue(data, zip64EndOffset, 8);
+        appendValue(data, 1, 4);              //total number of disks
+    }
+
+    appendValue(data, CPPZIP_END_OF_CENTRAL_DIR_SIGNATURE, 4);
+    appendValue(data, 0, 2);                  //number of this disk
+    appendValue(data, 0, 2);                  //disk with the central directory
+    appendValue(data, std::min<unsigned long long>(numEntries, 0xffff), 2);
+    appendValue(data, std::min<unsigned long long>(numEntries, 0xffff), 2);
+    appendValue(data, std::min<unsigned long long>(size, 0xffffffff), 4);
+    appendValue(data, std::min<unsigned long long>(offset, 0xffffffff), 4);
+    appendValue(data, std::min<size_t>(comment.size(), CPPZIP_MAX_COMMENT_SIZE), 2);
+    data.insert(data.end(), comment.begin(),
+                comment.begin() + std::min<size_t>(comment.size(), CPPZIP_MAX_COMMENT_SIZE));
+
+    return data;
+}
+
+} //cppzip
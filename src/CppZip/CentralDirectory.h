@@ -0,0 +1,137 @@
+/*
+ * CentralDirectory.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_CENTRALDIRECTORY_H_
+#define CPPZIP_CENTRALDIRECTORY_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cppzip {
+
+/*!
+ * \brief An entry of the central directory of a zip file.
+ *
+ * The sizes and the offset are already resolved from the zip64 extra field.
+ */
+struct CentralDirectoryEntry
+{
+    CentralDirectoryEntry();
+
+    std::string fileName;
+    unsigned int flag;                        /* general purpose bit flag */
+    unsigned int method;                      /* compression method */
+    unsigned long crc;                        /* crc-32 */
+    unsigned long long compressedSize;
+    unsigned long long uncompressedSize;
+    unsigned long long localHeaderOffset;     /* offset of the local header (as stored) */
+    std::vector<unsigned char> record;        /* the complete record as stored in the zip */
+};
+
+/*!
+ * \brief The central directory of a zip file.
+ */
+struct CentralDirectory
+{
+    CentralDirectory();
+
+    std::vector<CentralDirectoryEntry> entries;
+    unsigned long long numEntries;            /* number of entries (as stored in the end record) */
+    unsigned long long offset;                /* offset of the central directory (as stored) */
+    unsigned long long position;              /* real position of the central directory in the file */
+    unsigned long long size;                  /* size of the central directory */
+    std::string comment;                      /* the global comment */
+    std::vector<unsigned char> endRecord;     /* the end of central directory record incl. the comment */
+};
+
+/*!
+ * \brief Reads length bytes at offset into buffer.
+ *
+ * \return true if all bytes could be read, otherwise false.
+ */
+typedef std::function<bool (unsigned long long offset, unsigned char* buffer, size_t length)> ReadAt;
+
+/*!
+ * \brief Reads only the end records of the central directory of a zip file.
+ *
+ * The end of central directory record is searched at the end of the file
+ * (also the zip64 records). The entries stay empty.
+ *
+ * \param readAt reads from the zip file.
+ * \param fileSize is the size of the zip file.
+ * \param centralDirectory gets the position and the size of the central directory.
+ *
+ * \return true if the end records could be read, otherwise false.
+ */
+bool readEndOfCentralDirectory(const ReadAt& readAt,
+                               unsigned long long fileSize,
+                               CentralDirectory& centralDirectory);
+
+/*!
+ * \brief Reads the central directory of a zip file.
+ *
+ * The end of central directory record is searched at the end of the file
+ * (also the zip64 records). Then the records of the central directory are
+ * read in one piece.
+ *
+ * \param readAt reads from the zip file.
+ * \param fileSize is the size of the zip file.
+ * \param centralDirectory is filled with the entries.
+ *
+ * \return true if the central directory could be read, otherwise false.
+ */
+bool readCentralDirectory(const ReadAt& readAt,
+                          unsigned long long fileSize,
+                          CentralDirectory& centralDirectory);
+
+/*!
+ * \brief Builds a central directory with its end records.
+ *
+ * The records of entries are written unchanged. The zip64 end records are
+ * added, if the number of entries, the size or the offset needs them.
+ *
+ * \param entries are the entries of the central directory.
+ * \param offset is the offset (as stored) where the central directory will be written.
+ * \param comment is the global comment.
+ *
+ * \return the bytes of the central directory and the end records.
+ */
+std::vector<unsigned char> buildCentralDirectory(
+        const std::vector<const CentralDirectoryEntry*>& entries,
+        unsigned long long offset,
+        const std::string& comment);
+
+} //cppzip
+
+#endif /* CPPZIP_CENTRALDIRECTORY_H_ */
@@ -0,0 +1,250 @@
+/*
+ * CheckpointIndex.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "CheckpointIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#define CPPZIP_CHECKPOINT_FILE_MAGIC      "CPPZCKP"
+#define CPPZIP_CHECKPOINT_FILE_VERSION    1
+#define CPPZIP_CHECKPOINT_FILE_BYTE_ORDER 0x01020304
+
+namespace cppzip {
+
+namespace {
+
+/*
+ * The header of a checkpoint file. It is followed by the checkpoints, each
+ * one a CheckpointFileEntry followed by its window.
+ */
+struct CheckpointFileHeader
+{
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;                   /* CPPZIP_CHECKPOINT_FILE_BYTE_ORDER as written on the platform */
+    unsigned long long localHeaderOffset;
+    unsigned long long compressedSize;
+    unsigned long long uncompressedSize;
+    unsigned long long crc;
+    unsigned long long numCheckpoints;
+};
+
+struct CheckpointFileEntry
+{
+    unsigned long long uncompressedOffset;
+    unsigned long long compressedOffset;
+    unsigned int bits;
+    unsigned int windowSize;
+};
+
+CheckpointFileHeader createHeader(const FileInfoRecord& record)
+{
+    CheckpointFileHeader header = CheckpointFileHeader();
+    std::memcpy(header.magic, CPPZIP_CHECKPOINT_FILE_MAGIC, sizeof(CPPZIP_CHECKPOINT_FILE_MAGIC));
+    header.version = CPPZIP_CHECKPOINT_FILE_VERSION;
+    header.byteOrder = CPPZIP_CHECKPOINT_FILE_BYTE_ORDER;
+    header.localHeaderOffset = record.localHeaderOffset;
+    header.compressedSize = record.compressedSize;
+    header.uncompressedSize = record.uncompressedSize;
+    header.crc = record.crc;
+
+    return header;
+}
+
+} //anonymous namespace
+
+CheckpointIndex::CheckpointIndex()
+{
+
+}
+
+bool CheckpointIndex::build(const ReadAt& readAt, const FileInfoRecord& record, unsigned long long span)
+{
+    checkpoints.clear();
+
+    if(record.method != Z_DEFLATED){
+        return false;
+    }
+
+    EntryReader reader(readAt);
+    if(! reader.open(record) || ! reader.readAllWithCheckpoints(span, checkpoints)){
+        checkpoints.clear();
+        return false;
+    }
+
+    this->record = record;
+
+    return true;
+}
+
+const Checkpoint& CheckpointIndex::findCheckpoint(unsigned long long offset) const
+{
+    static const Checkpoint beginning;
+
+    //the checkpoints are sorted by their uncompressed offset
+    auto next = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset,
+                                 [](unsigned long long offset, const Checkpoint& checkpoint){
+        return offset < checkpoint.uncompressedOffset;
+    });
+
+    if(next == checkpoints.begin()){
+        return beginning;
+    }
+
+    return *(next - 1);
+}
+
+size_t CheckpointIndex::getNumCheckpoints() const
+{
+    return checkpoints.size();
+}
+
+bool CheckpointIndex::save(const std::string& fileName) const
+{
+    CheckpointFileHeader header = createHeader(record);
+    header.numCheckpoints = checkpoints.size();
+
+    try {
+        boost::filesystem::path filePath(fileName);
+        boost::filesystem::path tempFilePath = filePath;
+        tempFilePath += boost::filesystem::unique_path(".%%%%-%%%%-%%%%");
+
+        {
+            boost::filesystem::ofstream fs(tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(! fs.is_open()){
+                return false;
+            }
+
+            fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+            for(const auto& checkpoint : checkpoints){
+                CheckpointFileEntry entry = CheckpointFileEntry();
+                entry.uncompressedOffset = checkpoint.uncompressedOffset;
+                entry.compressedOffset = checkpoint.compressedOffset;
+                entry.bits = static_cast<unsigned int>(checkpoint.bits);
+                entry.windowSize = static_cast<unsigned int>(checkpoint.window.size());
+
+                fs.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+                fs.write(reinterpret_cast<const char*>(checkpoint.window.data()),
+                         static_cast<std::streamsize>(checkpoint.window.size()));
+            }
+
+            fs.close();
+
+            if(fs.fail()){
+                boost::filesystem::remove(tempFilePath);
+                return false;
+            }
+        }
+
+        boost::filesystem::rename(tempFilePath, filePath);
+    } catch (boost::filesystem::filesystem_error& e) {
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckpointIndex::load(const std::string& fileName, const FileInfoRecord& record)
+{
+    boost::filesystem::ifstream fs(fileName, std::ios::in | std::ios::binary);
+    if(! fs.is_open()){
+        return false;
+    }
+
+    CheckpointFileHeader header;
+    if(! fs.read(reinterpret_cast<char*>(&header), sizeof(header))){
+        return false;
+    }
+
+    CheckpointFileHeader expectedHeader = createHeader(record);
+    if(std::memcmp(header.magic, expectedHeader.magic, sizeof(header.magic)) != 0 ||
+       header.version != expectedHeader.version ||
+       header.byteOrder != expectedHeader.byteOrder ||
+       header.localHeaderOffset != expectedHeader.localHeaderOffset ||
+       header.compressedSize != expectedHeader.compressedSize ||
+       header.uncompressedSize != expectedHeader.uncompressedSize ||
+       header.crc != expectedHeader.crc ||
+       header.numCheckpoints == 0)
+    {
+        return false;
+    }
+
+    std::vector<Checkpoint> loadedCheckpoints;
+
+    for(unsigned long long i = 0; i < header.numCheckpoints; ++i){
+        CheckpointFileEntry entry;
+        if(! fs.read(reinterpret_cast<char*>(&entry), sizeof(entry))){
+            return false;
+        }
+
+        //the first checkpoint is the beginning, the others follow in ascending order
+        bool validOrder = loadedCheckpoints.empty()
+                ? entry.uncompressedOffset == 0 && entry.compressedOffset == 0
+                : entry.uncompressedOffset > loadedCheckpoints.back().uncompressedOffset;
+
+        if(! validOrder || entry.bits > 7 || entry.windowSize > CPPZIP_CHECKPOINT_WINDOW_SIZE ||
+           entry.uncompressedOffset > record.uncompressedSize ||
+           entry.compressedOffset > record.compressedSize)
+        {
+            return false;
+        }
+
+        Checkpoint checkpoint;
+        checkpoint.uncompressedOffset = entry.uncompressedOffset;
+        checkpoint.compressedOffset = entry.compressedOffset;
+        checkpoint.bits = static_cast<int>(entry.bits);
+        checkpoint.window.resize(entry.windowSize);
+
+        if(! fs.read(reinterpret_cast<char*>(checkpoint.window.data()), entry.windowSize)){
+            return false;
+        }
+
+        loadedCheckpoints.push_back(checkpoint);
+    }
+
+    //nothing may follow the checkpoints
+    if(fs.peek() != std::char_traits<char>::eof()){
+        return false;
+    }
+
+    checkpoints.swap(loadedCheckpoints);
+    this->record = record;
+
+    return true;
+}
+
+} //cppzip
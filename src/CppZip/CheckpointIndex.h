@@ -0,0 +1,109 @@
+/*
+ * CheckpointIndex.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_CHECKPOINTINDEX_H_
+#define CPPZIP_CHECKPOINTINDEX_H_
+
+#include "CentralDirectory.h"
+#include "EntryReader.h"
+#include "FileInfoIndex.h"
+
+#include <string>
+#include <vector>
+
+namespace cppzip {
+
+/*!
+ * \brief The checkpoints of a deflated file inside a zip, for reading at any position.
+ *
+ * The index is built by inflating the whole file once and saving a checkpoint
+ * about every span bytes (see zran.c of zlib). To read at a position, inflating
+ * starts at the checkpoint before it, so at most span bytes have to be inflated
+ * and thrown away. Each checkpoint needs up to 32 KiB of memory.
+ *
+ * The index can be saved into a file and loaded again. It is only loaded for
+ * the same file in the same zip (position, sizes and crc-32).
+ */
+class CheckpointIndex
+{
+public:
+    CheckpointIndex();
+
+    /*!
+     * \brief Builds the index for the deflated file of record.
+     *
+     * \param readAt reads the zip.
+     * \param record is the file inside the zip.
+     * \param span is the minimum distance between the checkpoints in the uncompressed data.
+     *
+     * \return true if the whole file could be read, otherwise false.
+     */
+    bool build(const ReadAt& readAt, const FileInfoRecord& record, unsigned long long span);
+
+    /*!
+     * \brief Gets the last checkpoint at or before offset in the uncompressed data.
+     *
+     * An empty index returns the beginning of the file.
+     */
+    const Checkpoint& findCheckpoint(unsigned long long offset) const;
+
+    /*!
+     * \brief Gets the number of checkpoints.
+     */
+    size_t getNumCheckpoints() const;
+
+    /*!
+     * \brief Saves the index into a file.
+     *
+     * The file is written next to fileName and renamed at the end, so a
+     * reader never sees a half written file.
+     *
+     * \return true if the index could be saved, otherwise false.
+     */
+    bool save(const std::string& fileName) const;
+
+    /*!
+     * \brief Loads the index from a file saved with save().
+     *
+     * \return true if the file is a valid index of the file of record, otherwise false.
+     */
+    bool load(const std::string& fileName, const FileInfoRecord& record);
+
+private:
+    FileInfoRecord record;
+    std::vector<Checkpoint> checkpoints;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_CHECKPOINTINDEX_H_ */
@@ -89,6 +89,43 @@
  *  //close
  *  zip->close();
  * \endcode
+ *
+ * \section add_a_file_piece_by_piece Writes generated content piece by piece into a file inside the zip:
+ * \code
+ *  //open zip file
+ *  Zip zip;
+ *  zip.open("file.zip");
+ *
+ *  //write the content while it is generated
+ *  std::shared_ptr<ZipFileWriter> writer = zip.openFileWriter("report.txt");
+ *  while(hasMoreLines()){
+ *      std::string line = nextLine();
+ *      writer->write((const unsigned char*)line.data(), line.size());
+ *  }
+ *  writer->close();
+ *
+ *  //close
+ *  zip.close();
+ * \endcode
+ *
+ * \section change_many_files Replaces and deletes many files with one rewrite of the zip:
+ * \code
+ *  //open zip file
+ *  Zip zip;
+ *  zip.open("file.zip", OpenFlags::OpenExisting);
+ *
+ *  //collect the changes
+ *  ZipTransaction transaction;
+ *  transaction.replaceFile("data/config.xml", "config.xml");
+ *  transaction.deleteFile("old.txt");
+ *  transaction.addFile("new.txt", content);
+ *
+ *  //apply them at once
+ *  zip.commit(transaction);
+ *
+ *  //close
+ *  zip.close();
+ * \endcode
 */
 
 /*!
@@ -136,6 +173,25 @@
  *  //close zip
  *  zip.close();
  * \endcode
+ *
+ * \section reads_piece_by_piece Reads a big file from zip piece by piece:
+ * \code
+ *  //open zip file
+ *  Unzip zip;
+ *  zip.open("file.zip");
+ *
+ *  //read the content in pieces of 64 KiB
+ *  std::shared_ptr<UnzipFileReader> reader = zip.openFileReader("big_file.txt");
+ *  unsigned char buffer[65536];
+ *  long long len = 0;
+ *  while((len = reader->read(buffer, sizeof(buffer))) > 0){
+ *      std::cout.write((const char*)buffer, len);
+ *  }
+ *  reader->close();
+ *
+ *  //close zip
+ *  zip.close();
+ * \endcode
 */
 
 /*!
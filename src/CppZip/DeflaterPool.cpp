@@ -0,0 +1,153 @@
+/*
+ * DeflaterPool.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "DeflaterPool.h"
+
+#include <algorithm>
+#include <iterator>
+
+#ifndef DEF_MEM_LEVEL
+#  if MAX_MEM_LEVEL >= 8
+#    define DEF_MEM_LEVEL 8
+#  else
+#    define DEF_MEM_LEVEL  MAX_MEM_LEVEL
+#  endif
+#endif
+
+namespace cppzip {
+
+struct DeflaterPool::Deflater
+{
+    z_stream stream;
+    int compressionLevel;
+};
+
+DeflaterPool& DeflaterPool::getInstance()
+{
+    //never destroyed: compressors may still release into it while static objects are destroyed
+    static DeflaterPool* instance = new DeflaterPool();
+    return *instance;
+}
+
+DeflaterPool::DeflaterPool(size_t maxPooled)
+    : maxPooled(maxPooled)
+{
+
+}
+
+DeflaterPool::~DeflaterPool()
+{
+    for(auto deflater : deflaters){
+        endDeflater(deflater);
+    }
+}
+
+std::shared_ptr<z_stream> DeflaterPool::acquireDeflater(int compressionLevel)
+{
+    Deflater* deflater = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        //prefer a state with the same level, it needs no deflateParams()
+        auto found = std::find_if(deflaters.rbegin(), deflaters.rend(), [compressionLevel](Deflater* deflater){
+            return deflater->compressionLevel == compressionLevel;
+        });
+
+        if(found != deflaters.rend()){
+            deflater = *found;
+            deflaters.erase(std::next(found).base());
+        } else if(! deflaters.empty()){
+            deflater = deflaters.back();
+            deflaters.pop_back();
+        }
+    }
+
+    if(deflater != NULL && deflater->compressionLevel != compressionLevel){
+        //deflateParams() may flush, the reset afterwards starts a clean stream with the new level
+        if(Z_OK == deflateParams(&deflater->stream, compressionLevel, Z_DEFAULT_STRATEGY) &&
+           Z_OK == deflateReset(&deflater->stream))
+        {
+            deflater->compressionLevel = compressionLevel;
+        } else {
+            endDeflater(deflater);
+            deflater = NULL;
+        }
+    }
+
+    if(deflater == NULL){
+        deflater = new Deflater();
+        deflater->stream.zalloc = Z_NULL;
+        deflater->stream.zfree = Z_NULL;
+        deflater->stream.opaque = Z_NULL;
+        deflater->compressionLevel = compressionLevel;
+
+        if(Z_OK != deflateInit2(&deflater->stream, compressionLevel, Z_DEFLATED,
+                                -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY)){
+            delete deflater;
+            return std::shared_ptr<z_stream>();
+        }
+    }
+
+    return std::shared_ptr<z_stream>(&deflater->stream, [this, deflater](z_stream*){
+        releaseDeflater(deflater);
+    });
+}
+
+void DeflaterPool::endDeflater(Deflater* deflater)
+{
+    deflateEnd(&deflater->stream);
+    delete deflater;
+}
+
+size_t DeflaterPool::getNumPooledDeflaters()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return deflaters.size();
+}
+
+void DeflaterPool::releaseDeflater(Deflater* deflater)
+{
+    //also a stream that stopped with an error can be reset
+    if(Z_OK == deflateReset(&deflater->stream)){
+        std::lock_guard<std::mutex> lock(mutex);
+        if(deflaters.size() < maxPooled){
+            deflaters.push_back(deflater);
+            return;
+        }
+    }
+
+    endDeflater(deflater);
+}
+
+} //cppzip
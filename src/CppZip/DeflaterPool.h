@@ -0,0 +1,119 @@
+/*
+ * DeflaterPool.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_DEFLATERPOOL_H_
+#define CPPZIP_DEFLATERPOOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <zlib.h>
+
+/*! \brief Maximum number of deflate states kept by a DeflaterPool. */
+#define CPPZIP_DEFLATER_POOL_MAX_SIZE 16
+
+namespace cppzip {
+
+/*!
+ * \brief Keeps deflate states to reuse them for the next file or block.
+ *
+ * deflateInit2() allocates about 256 KiB for the window and the hash tables
+ * and deflateEnd() frees them again, for many small files this is a big part
+ * of the work. A released deflate state is reset with deflateReset() and handed
+ * out again by the next acquireDeflater(), deflateParams() switches it to
+ * another compression level if needed.
+ *
+ * The states write raw deflate streams (no zlib header) with the same
+ * parameters as minizip uses, so the result is the same as when the data is
+ * written with zipWriteInFileInZip().
+ *
+ * The pool is used where the data is compressed in memory and written raw,
+ * by the worker threads of addFiles() and addFolder() and by ParallelDeflate.
+ * Files streamed through minizip (addFile() with one thread and
+ * ZipFileWriter) still use the deflate state of minizip.
+ *
+ * The pool is thread safe. getInstance() is shared by all Zip instances and by
+ * the threads that compress in parallel. Acquired states are given back to the
+ * pool when their last shared_ptr is released, so the pool must outlive them.
+ */
+class DeflaterPool
+{
+public:
+    /*!
+     * \brief Gets the pool shared by all Zip instances, it lives until the program exits.
+     */
+    static DeflaterPool& getInstance();
+
+    /*!
+     * \brief Creates a pool that keeps at most maxPooled deflate states.
+     */
+    explicit DeflaterPool(size_t maxPooled = CPPZIP_DEFLATER_POOL_MAX_SIZE);
+
+    /*!
+     * \brief Frees the pooled deflate states.
+     */
+    ~DeflaterPool();
+
+    /*!
+     * \brief Gets a deflate state that is ready for a new raw deflate stream.
+     *
+     * \param compressionLevel is the level of compression (0-9 or Z_DEFAULT_COMPRESSION).
+     *
+     * \return the deflate state or an empty pointer if it couldn't be initialized.
+     */
+    std::shared_ptr<z_stream> acquireDeflater(int compressionLevel);
+
+    /*!
+     * \brief Gets the number of deflate states that wait in the pool.
+     */
+    size_t getNumPooledDeflaters();
+
+private:
+    DeflaterPool(const DeflaterPool&);
+    DeflaterPool& operator=(const DeflaterPool&);
+
+    struct Deflater;
+
+    void releaseDeflater(Deflater* deflater);
+    static void endDeflater(Deflater* deflater);
+
+private:
+    std::mutex mutex;
+    std::vector<Deflater*> deflaters;
+    size_t maxPooled;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_DEFLATERPOOL_H_ */
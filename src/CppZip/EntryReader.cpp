@@ -0,0 +1,449 @@
+/*
+ * EntryReader.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "EntryReader.h"
+
+#include <algorithm>
+
+#define CPPZIP_LOCAL_HEADER_SIGNATURE  0x04034b50
+#define CPPZIP_LOCAL_HEADER_SIZE       30
+#define CPPZIP_FLAG_ENCRYPTED          0x1
+#define CPPZIP_METHOD_STORED           0
+#define CPPZIP_MAX_INFLATE_CHUNK       0x40000000
+
+namespace cppzip {
+
+namespace {
+
+unsigned long long readValue(const unsigned char* data, size_t numBytes)
+{
+    unsigned long long value = 0;
+    for(size_t i = numBytes; i > 0; --i){
+        value = (value << 8) | data[i - 1];
+    }
+    return value;
+}
+
+unsigned long updateCrc(unsigned long crc, const unsigned char* data, unsigned long long length)
+{
+    while(length > 0){
+        uInt chunk = static_cast<uInt>(std::min<unsigned long long>(length, CPPZIP_MAX_INFLATE_CHUNK));
+        crc = crc32(crc, data, chunk);
+        data += chunk;
+        length -= chunk;
+    }
+    return crc;
+}
+
+} //anonymous namespace
+
+Checkpoint::Checkpoint()
+    : uncompressedOffset(0)
+    , compressedOffset(0)
+    , bits(0)
+{
+
+}
+
+EntryReader::EntryReader(const ReadAt& readAt, InflaterPool& pool)
+    : readAt(readAt)
+    , pool(pool)
+    , opened(false)
+    , endOfFile(false)
+    , failed(false)
+    , verifyCrc(true)
+    , dataPosition(0)
+    , compressedRemaining(0)
+    , uncompressedRead(0)
+    , crc(0)
+{
+
+}
+
+EntryReader::~EntryReader()
+{
+    close();
+}
+
+bool EntryReader::canRead(const FileInfoRecord& record)
+{
+    return ! isEncrypted(record) &&
+           (record.method == CPPZIP_METHOD_STORED || record.method == Z_DEFLATED);
+}
+
+bool EntryReader::isEncrypted(const FileInfoRecord& record)
+{
+    return (record.flag & CPPZIP_FLAG_ENCRYPTED) != 0;
+}
+
+bool EntryReader::open(const FileInfoRecord& record)
+{
+    return open(record, Checkpoint());
+}
+
+bool EntryReader::open(const FileInfoRecord& record, const Checkpoint& checkpoint)
+{
+    close();
+
+    unsigned long long dataStart = 0;
+    if(! readAt || ! canRead(record) || ! readDataPosition(record, dataStart)){
+        return false;
+    }
+
+    //in a stored file the compressed and the uncompressed positions are the same
+    unsigned long long compressedOffset = record.method == Z_DEFLATED
+            ? checkpoint.compressedOffset
+            : checkpoint.uncompressedOffset;
+
+    if(checkpoint.uncompressedOffset > record.uncompressedSize || compressedOffset > record.compressedSize){
+        return false;
+    }
+
+    if(record.method == Z_DEFLATED){
+        stream = pool.acquireInflater();
+        if(! stream){
+            return false;
+        }
+
+        inputBuffer = pool.acquireBuffer();
+
+        //the deflate block of the checkpoint starts inside the byte before
+        if(checkpoint.bits > 0){
+            unsigned char byte;
+            if(compressedOffset == 0 ||
+               ! readAt(dataStart + compressedOffset - 1, &byte, 1) ||
+               Z_OK != inflatePrime(stream.get(), checkpoint.bits, byte >> (8 - checkpoint.bits)))
+            {
+                close();
+                return false;
+            }
+        }
+
+        if(! checkpoint.window.empty() &&
+           Z_OK != inflateSetDictionary(stream.get(), checkpoint.window.data(),
+                                        static_cast<uInt>(checkpoint.window.size())))
+        {
+            close();
+            return false;
+        }
+    }
+
+    this->record = record;
+    dataPosition = dataStart + compressedOffset;
+    compressedRemaining = record.compressedSize - compressedOffset;
+    uncompressedRead = checkpoint.uncompressedOffset;
+    crc = crc32(0L, Z_NULL, 0);
+    verifyCrc = uncompressedRead == 0;
+    endOfFile = false;
+    failed = false;
+    opened = true;
+
+    return true;
+}
+
+long long EntryReader::read(unsigned char* buffer, unsigned long long size)
+{
+    if(! opened || failed){
+        return -1;
+    }
+
+    if(endOfFile){
+        return 0;
+    }
+
+    long long numRead = record.method == Z_DEFLATED
+            ? readDeflated(buffer, size)
+            : readStored(buffer, size);
+
+    if(numRead < 0){
+        failed = true;
+        return -1;
+    }
+
+    if(verifyCrc){
+        crc = updateCrc(crc, buffer, static_cast<unsigned long long>(numRead));
+    }
+    uncompressedRead += static_cast<unsigned long long>(numRead);
+
+    if(endOfFile && ! finish()){
+        failed = true;
+        return -1;
+    }
+
+    return numRead;
+}
+
+bool EntryReader::readAll(unsigned char* buffer)
+{
+    long long numRead = read(buffer, record.uncompressedSize);
+    if(numRead < 0 || static_cast<unsigned long long>(numRead) != record.uncompressedSize){
+        return false;
+    }
+
+    //the end of a deflate stream is only seen by one more read
+    unsigned char probe;
+    return endOfFile || read(&probe, 1) == 0;
+}
+
+long long EntryReader::skip(unsigned long long size)
+{
+    if(! opened || failed){
+        return -1;
+    }
+
+    verifyCrc = false;
+
+    //a stored file is skipped by moving the position
+    if(record.method != Z_DEFLATED){
+        unsigned long long toSkip = std::min(size, compressedRemaining);
+        dataPosition += toSkip;
+        compressedRemaining -= toSkip;
+        uncompressedRead += toSkip;
+
+        if(compressedRemaining == 0){
+            endOfFile = true;
+            if(! finish()){
+                failed = true;
+                return -1;
+            }
+        }
+
+        return static_cast<long long>(toSkip);
+    }
+
+    std::shared_ptr<InflaterPool::Buffer> discard = pool.acquireBuffer();
+    unsigned long long total = 0;
+
+    while(total < size){
+        long long numRead = read(discard->data(), std::min<unsigned long long>(size - total, discard->size()));
+        if(numRead < 0){
+            return -1;
+        }
+
+        if(numRead == 0){
+            break;
+        }
+
+        total += static_cast<unsigned long long>(numRead);
+    }
+
+    return static_cast<long long>(total);
+}
+
+bool EntryReader::readAllWithCheckpoints(unsigned long long span, std::vector<Checkpoint>& checkpoints)
+{
+    checkpoints.clear();
+
+    if(! opened || failed || endOfFile || record.method != Z_DEFLATED || uncompressedRead != 0){
+        return false;
+    }
+
+    checkpoints.push_back(Checkpoint());
+
+    //the last 32 KiB of the uncompressed data, it is written round and round
+    std::vector<unsigned char> window(CPPZIP_CHECKPOINT_WINDOW_SIZE);
+    unsigned long long compressedRead = 0;
+    unsigned long long lastCheckpoint = 0;
+    int err = Z_OK;
+
+    stream->avail_out = 0;
+
+    while(err != Z_STREAM_END){
+        if(! fillInputBuffer()){
+            failed = true;
+            return false;
+        }
+
+        if(stream->avail_out == 0){
+            stream->next_out = window.data();
+            stream->avail_out = static_cast<uInt>(window.size());
+        }
+
+        uInt availableIn = stream->avail_in;
+        uInt availableOut = stream->avail_out;
+        unsigned char* output = stream->next_out;
+
+        //stops at the end of each deflate block
+        err = inflate(stream.get(), Z_BLOCK);
+
+        unsigned long long numInflated = availableOut - stream->avail_out;
+        compressedRead += availableIn - stream->avail_in;
+        crc = updateCrc(crc, output, numInflated);
+        uncompressedRead += numInflated;
+
+        if(err != Z_OK && err != Z_STREAM_END &&
+           ! (err == Z_BUF_ERROR && (stream->avail_in > 0 || compressedRemaining > 0)))
+        {
+            failed = true;
+            return false;
+        }
+
+        //at the end of a block, which is not the last block
+        bool endOfBlock = (stream->data_type & 128) && ! (stream->data_type & 64);
+
+        if(err == Z_OK && endOfBlock && uncompressedRead - lastCheckpoint > span){
+            Checkpoint checkpoint;
+            checkpoint.uncompressedOffset = uncompressedRead;
+            checkpoint.compressedOffset = compressedRead;
+            checkpoint.bits = stream->data_type & 7;
+
+            //the oldest bytes are behind the write position of the window
+            size_t writePosition = window.size() - stream->avail_out;
+            size_t length = static_cast<size_t>(std::min<unsigned long long>(uncompressedRead, window.size()));
+            size_t olderLength = length - std::min(length, writePosition);
+
+            checkpoint.window.resize(length);
+            std::copy(window.end() - olderLength, window.end(), checkpoint.window.begin());
+            std::copy(window.begin() + (writePosition - (length - olderLength)),
+                      window.begin() + writePosition,
+                      checkpoint.window.begin() + olderLength);
+
+            checkpoints.push_back(checkpoint);
+            lastCheckpoint = uncompressedRead;
+        }
+    }
+
+    endOfFile = true;
+    if(! finish()){
+        failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool EntryReader::isEndOfFile() const
+{
+    return endOfFile;
+}
+
+void EntryReader::close()
+{
+    stream.reset();
+    inputBuffer.reset();
+
+    opened = false;
+}
+
+long long EntryReader::readStored(unsigned char* buffer, unsigned long long size)
+{
+    unsigned long long toRead = std::min(size, compressedRemaining);
+
+    if(toRead > 0 && ! readAt(dataPosition, buffer, static_cast<size_t>(toRead))){
+        return -1;
+    }
+
+    dataPosition += toRead;
+    compressedRemaining -= toRead;
+    endOfFile = compressedRemaining == 0;
+
+    return static_cast<long long>(toRead);
+}
+
+long long EntryReader::readDeflated(unsigned char* buffer, unsigned long long size)
+{
+    unsigned long long total = 0;
+
+    while(total < size){
+        if(! fillInputBuffer()){
+            return -1;
+        }
+
+        uInt chunk = static_cast<uInt>(std::min<unsigned long long>(size - total, CPPZIP_MAX_INFLATE_CHUNK));
+        stream->next_out = buffer + total;
+        stream->avail_out = chunk;
+
+        int err = inflate(stream.get(), Z_SYNC_FLUSH);
+        total += chunk - stream->avail_out;
+
+        if(err == Z_STREAM_END){
+            endOfFile = true;
+            break;
+        }
+
+        //the compressed data ended before the deflate stream
+        if(err == Z_BUF_ERROR && stream->avail_in == 0 && compressedRemaining == 0){
+            return -1;
+        }
+
+        if(err != Z_OK && err != Z_BUF_ERROR){
+            return -1;
+        }
+    }
+
+    return static_cast<long long>(total);
+}
+
+bool EntryReader::readDataPosition(const FileInfoRecord& record, unsigned long long& position)
+{
+    //the data follows the local header, whose name and extra field can differ from the central directory
+    unsigned char localHeader[CPPZIP_LOCAL_HEADER_SIZE];
+    if(! readAt(record.localHeaderOffset, localHeader, sizeof(localHeader)) ||
+       readValue(localHeader, 4) != CPPZIP_LOCAL_HEADER_SIGNATURE)
+    {
+        return false;
+    }
+
+    unsigned long long fileNameLength = readValue(localHeader + 26, 2);
+    unsigned long long extraLength = readValue(localHeader + 28, 2);
+
+    position = record.localHeaderOffset + CPPZIP_LOCAL_HEADER_SIZE + fileNameLength + extraLength;
+
+    return true;
+}
+
+bool EntryReader::fillInputBuffer()
+{
+    if(stream->avail_in > 0 || compressedRemaining == 0){
+        return true;
+    }
+
+    size_t toRead = static_cast<size_t>(std::min<unsigned long long>(inputBuffer->size(), compressedRemaining));
+    if(! readAt(dataPosition, inputBuffer->data(), toRead)){
+        return false;
+    }
+
+    dataPosition += toRead;
+    compressedRemaining -= toRead;
+    stream->next_in = inputBuffer->data();
+    stream->avail_in = static_cast<uInt>(toRead);
+
+    return true;
+}
+
+bool EntryReader::finish()
+{
+    return (! verifyCrc || crc == record.crc) && uncompressedRead == record.uncompressedSize;
+}
+
+} //cppzip
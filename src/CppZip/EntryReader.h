@@ -0,0 +1,213 @@
+/*
+ * EntryReader.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_ENTRYREADER_H_
+#define CPPZIP_ENTRYREADER_H_
+
+#include "CentralDirectory.h"
+#include "FileInfoIndex.h"
+#include "InflaterPool.h"
+
+#include <memory>
+#include <vector>
+#include <zlib.h>
+
+/*! \brief Size of the window of a deflate stream, the uncompressed data a checkpoint needs. */
+#define CPPZIP_CHECKPOINT_WINDOW_SIZE 32768
+
+namespace cppzip {
+
+/*!
+ * \brief A position in a file inside a zip, where reading can start (like zran.c of zlib).
+ *
+ * Inflating can only start at the beginning of a deflate block and needs the
+ * last 32 KiB of the uncompressed data before it. The default checkpoint is the
+ * beginning of the file.
+ */
+struct Checkpoint
+{
+    Checkpoint();
+
+    unsigned long long uncompressedOffset;    /* position in the uncompressed data */
+    unsigned long long compressedOffset;      /* position of the first full byte in the compressed data */
+    int bits;                                 /* number of bits (0-7) of the deflate block in the byte before */
+    std::vector<unsigned char> window;        /* the uncompressed data before the checkpoint, at most 32 KiB */
+};
+
+/*!
+ * \brief Reads and inflates a file inside a zip with positional reads.
+ *
+ * The reader has its own inflate state and reads the compressed data with
+ * readAt at the position of the file, it doesn't use a minizip handle. So
+ * several readers can read from one zip at the same time, each in its own
+ * thread.
+ *
+ * Only files that are not encrypted and that are stored or deflated can be
+ * read (see canRead()). At the end of the file the crc-32 and the size are
+ * checked against the record.
+ *
+ * The inflate state and the buffer for the compressed data are taken from an
+ * InflaterPool when a file is opened and given back when it is closed.
+ */
+class EntryReader
+{
+public:
+    explicit EntryReader(const ReadAt& readAt, InflaterPool& pool = InflaterPool::getInstance());
+
+    /*!
+     * \brief Closes the reader.
+     */
+    ~EntryReader();
+
+    /*!
+     * \brief Checks if the file of record can be read by an EntryReader.
+     */
+    static bool canRead(const FileInfoRecord& record);
+
+    /*!
+     * \brief Checks if the file of record is encrypted.
+     */
+    static bool isEncrypted(const FileInfoRecord& record);
+
+    /*!
+     * \brief Opens the file of record to read it.
+     *
+     * \return true if the local header is valid and the file can be read, otherwise false.
+     */
+    bool open(const FileInfoRecord& record);
+
+    /*!
+     * \brief Opens the file of record to read it from the checkpoint on.
+     *
+     * For a stored file every position is a checkpoint, only the uncompressed
+     * offset is used. When the reading doesn't start at the beginning of the
+     * file, the crc-32 can't be checked, only the size.
+     *
+     * \return true if the local header is valid and the file can be read, otherwise false.
+     */
+    bool open(const FileInfoRecord& record, const Checkpoint& checkpoint);
+
+    /*!
+     * \brief Reads the next bytes of the file into buffer.
+     *
+     * Reads until buffer is full or the end of the file is reached.
+     *
+     * \return the number of bytes read, 0 at the end of the file or -1 on
+     *         error (also if the crc-32 or the size is wrong).
+     */
+    long long read(unsigned char* buffer, unsigned long long size);
+
+    /*!
+     * \brief Reads the whole file into buffer, which holds the uncompressed size of the record.
+     *
+     * \return true if the whole file is read and it has the expected size, otherwise false.
+     */
+    bool readAll(unsigned char* buffer);
+
+    /*!
+     * \brief Skips the next size bytes of the file.
+     *
+     * A stored file is skipped without reading it, a deflated file is inflated
+     * into a pooled buffer and the data is thrown away. The crc-32 of the file
+     * isn't checked after a skip.
+     *
+     * \return the number of bytes skipped, less than size at the end of the
+     *         file, or -1 on error.
+     */
+    long long skip(unsigned long long size);
+
+    /*!
+     * \brief Reads the whole deflated file and collects checkpoints on the way.
+     *
+     * The reader must be opened at the beginning of the file. A checkpoint is
+     * set at the end of a deflate block, if more than span bytes are inflated
+     * since the last checkpoint. The first checkpoint is the beginning of the file.
+     *
+     * \return true if the whole file is read and the crc-32 and the size are ok, otherwise false.
+     */
+    bool readAllWithCheckpoints(unsigned long long span, std::vector<Checkpoint>& checkpoints);
+
+    /*!
+     * \brief Reads the position of the data of the file of record in the zip, it follows the local header.
+     *
+     * \return true if the local header is valid, otherwise false.
+     */
+    bool readDataPosition(const FileInfoRecord& record, unsigned long long& position);
+
+    /*!
+     * \brief Checks if the end of the file is reached.
+     */
+    bool isEndOfFile() const;
+
+    /*!
+     * \brief Closes the file and gives the inflate state back to the pool.
+     */
+    void close();
+
+private:
+    EntryReader(const EntryReader&);
+    EntryReader& operator=(const EntryReader&);
+
+    long long readStored(unsigned char* buffer, unsigned long long size);
+    long long readDeflated(unsigned char* buffer, unsigned long long size);
+
+    /*
+     * Fills the input buffer, if the inflate state has consumed it.
+     */
+    bool fillInputBuffer();
+
+    /*
+     * Checks the crc-32 and the size at the end of the file.
+     */
+    bool finish();
+
+private:
+    ReadAt readAt;
+    InflaterPool& pool;
+    FileInfoRecord record;
+    std::shared_ptr<z_stream> stream;
+    std::shared_ptr<InflaterPool::Buffer> inputBuffer;
+
+    bool opened;
+    bool endOfFile;
+    bool failed;
+    bool verifyCrc;                           /* false if not all data is passed through read() */
+    unsigned long long dataPosition;          /* position of the next compressed byte in the zip */
+    unsigned long long compressedRemaining;
+    unsigned long long uncompressedRead;
+    unsigned long crc;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_ENTRYREADER_H_ */
@@ -0,0 +1,509 @@
+/*
+ * FileInfoIndex.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "FileInfoIndex.h"
+#include "CentralDirectory.h"
+#include "MemoryMappedFile.h"
+
+#include <cstring>
+#include <utility>
+#include <zlib.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#define CPPZIP_FILE_INFO_INDEX_MIN_SLOTS 16
+#define CPPZIP_FNV_OFFSET_BASIS          2166136261u
+#define CPPZIP_FNV_PRIME                 16777619u
+
+#define CPPZIP_INDEX_FILE_MAGIC          "CPPZIDX"
+#define CPPZIP_INDEX_FILE_VERSION        2
+#define CPPZIP_INDEX_FILE_BYTE_ORDER     0x01020304
+
+namespace cppzip {
+
+namespace {
+
+/*
+ * The header of an index file. It is followed by the entries, the slots
+ * and the names.
+ */
+struct IndexFileHeader
+{
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;                   /* CPPZIP_INDEX_FILE_BYTE_ORDER as written on the platform */
+    unsigned int entrySize;
+    unsigned int reserved;
+    ZipFileStamp stamp;
+    unsigned long long numEntries;
+    unsigned long long namesSize;
+    unsigned long long numSlots;
+    unsigned long long numUsedSlots;
+    unsigned long long numFiles;
+};
+
+unsigned int hashFileName(const std::string& fileName)
+{
+    //FNV-1a
+    unsigned int hash = CPPZIP_FNV_OFFSET_BASIS;
+    for(const char c : fileName){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= CPPZIP_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+size_t numSlotsFor(size_t numFiles)
+{
+    //keeps the hash table at most half full
+    size_t numSlots = CPPZIP_FILE_INFO_INDEX_MIN_SLOTS;
+    while(numSlots < numFiles * 2){
+        numSlots *= 2;
+    }
+
+    return numSlots;
+}
+
+IndexFileHeader createHeader(size_t entrySize, const ZipFileStamp& stamp)
+{
+    IndexFileHeader header = IndexFileHeader();
+    std::memcpy(header.magic, CPPZIP_INDEX_FILE_MAGIC, sizeof(CPPZIP_INDEX_FILE_MAGIC));
+    header.version = CPPZIP_INDEX_FILE_VERSION;
+    header.byteOrder = CPPZIP_INDEX_FILE_BYTE_ORDER;
+    header.entrySize = static_cast<unsigned int>(entrySize);
+    header.stamp = stamp;
+
+    return header;
+}
+
+} //anonymous namespace
+
+FileInfoRecord::FileInfoRecord()
+    : posInZipDirectory(0)
+    , numOfFile(0)
+    , compressedSize(0)
+    , uncompressedSize(0)
+    , localHeaderOffset(0)
+    , crc(0)
+    , dosDate(0)
+    , externalAttributes(0)
+    , internalAttributes(0)
+    , method(0)
+    , flag(0)
+{
+
+}
+
+ZipFileStamp::ZipFileStamp()
+    : fileSize(0)
+    , modificationTime(0)
+    , numEntries(0)
+    , centralDirectoryOffset(0)
+    , centralDirectorySize(0)
+    , endRecordCrc(0)
+    , reserved(0)
+{
+
+}
+
+bool ZipFileStamp::operator==(const ZipFileStamp& other) const
+{
+    return fileSize == other.fileSize &&
+           modificationTime == other.modificationTime &&
+           numEntries == other.numEntries &&
+           centralDirectoryOffset == other.centralDirectoryOffset &&
+           centralDirectorySize == other.centralDirectorySize &&
+           endRecordCrc == other.endRecordCrc;
+}
+
+bool readZipFileStamp(const std::string& zipFileName, ZipFileStamp& stamp)
+{
+    try {
+        boost::filesystem::ifstream fs(zipFileName, std::ios::in | std::ios::binary);
+        if(! fs.is_open()){
+            return false;
+        }
+
+        ZipFileStamp newStamp;
+        newStamp.fileSize = boost::filesystem::file_size(zipFileName);
+        newStamp.modificationTime = static_cast<long long>(boost::filesystem::last_write_time(zipFileName));
+
+        ReadAt readAt = [&fs](unsigned long long offset, unsigned char* data, size_t length){
+            fs.seekg(static_cast<std::streamoff>(offset));
+            fs.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(length));
+            return fs.good() && static_cast<size_t>(fs.gcount()) == length;
+        };
+
+        CentralDirectory centralDirectory;
+        if(! readEndOfCentralDirectory(readAt, newStamp.fileSize, centralDirectory)){
+            return false;
+        }
+
+        newStamp.numEntries = centralDirectory.numEntries;
+        newStamp.centralDirectoryOffset = centralDirectory.offset;
+        newStamp.centralDirectorySize = centralDirectory.size;
+        newStamp.endRecordCrc = static_cast<unsigned int>(
+                crc32(0L, centralDirectory.endRecord.data(),
+                      static_cast<uInt>(centralDirectory.endRecord.size())));
+
+        stamp = newStamp;
+    } catch (boost::filesystem::filesystem_error& e) {
+        return false;
+    }
+
+    return true;
+}
+
+FileInfoIndex::FileInfoIndex()
+    : entryData(NULL)
+    , nameData(NULL)
+    , slotData(NULL)
+    , numEntries(0)
+    , namesSize(0)
+    , numSlots(0)
+    , numUsedSlots(0)
+    , numFiles(0)
+{
+
+}
+
+void FileInfoIndex::reserve(size_t numFiles, size_t namesSize)
+{
+    detach();
+
+    entries.reserve(numFiles);
+    names.reserve(namesSize);
+
+    if(slots.size() < numSlotsFor(numFiles)){
+        rehash(numSlotsFor(numFiles));
+    }
+
+    updateData();
+}
+
+bool FileInfoIndex::insert(const std::string& fileName, const FileInfoRecord& record)
+{
+    detach();
+
+    if((numUsedSlots + 1) * 2 > slots.size()){
+        rehash(numSlotsFor(numFiles + 1));
+        updateData();
+    }
+
+    unsigned int hash = hashFileName(fileName);
+    size_t slot = findSlot(fileName, hash);
+
+    //all slots are used only in a broken index file
+    if(slot == numSlots || slots[slot] != 0){
+        return false;
+    }
+
+    Entry entry = Entry();
+    entry.record = record;
+    entry.nameOffset = names.size();
+    entry.nameLength = static_cast<unsigned int>(fileName.size());
+    entry.hash = hash;
+    entry.erased = 0;
+
+    names.append(fileName);
+    entries.push_back(entry);
+
+    slots[slot] = static_cast<unsigned int>(entries.size());
+    ++numUsedSlots;
+    ++numFiles;
+
+    updateData();
+
+    return true;
+}
+
+const FileInfoRecord* FileInfoIndex::find(const std::string& fileName) const
+{
+    if(numFiles == 0){
+        return NULL;
+    }
+
+    size_t slot = findSlot(fileName, hashFileName(fileName));
+    if(slot == numSlots || slotData[slot] == 0){
+        return NULL;
+    }
+
+    return &entryData[slotData[slot] - 1].record;
+}
+
+bool FileInfoIndex::contains(const std::string& fileName) const
+{
+    return find(fileName) != NULL;
+}
+
+bool FileInfoIndex::erase(const std::string& fileName)
+{
+    if(! contains(fileName)){
+        return false;
+    }
+
+    detach();
+
+    //the slot stays used, so the probing goes on behind it
+    size_t slot = findSlot(fileName, hashFileName(fileName));
+    if(slot == numSlots){
+        return false;
+    }
+
+    entries[slots[slot] - 1].erased = 1;
+    --numFiles;
+
+    return true;
+}
+
+size_t FileInfoIndex::size() const
+{
+    return numFiles;
+}
+
+bool FileInfoIndex::empty() const
+{
+    return numFiles == 0;
+}
+
+void FileInfoIndex::clear()
+{
+    std::vector<Entry>().swap(entries);
+    std::string().swap(names);
+    std::vector<unsigned int>().swap(slots);
+    indexFile.reset();
+    numUsedSlots = 0;
+    numFiles = 0;
+
+    updateData();
+}
+
+void FileInfoIndex::swap(FileInfoIndex& other)
+{
+    entries.swap(other.entries);
+    names.swap(other.names);
+    slots.swap(other.slots);
+    indexFile.swap(other.indexFile);
+    std::swap(entryData, other.entryData);
+    std::swap(nameData, other.nameData);
+    std::swap(slotData, other.slotData);
+    std::swap(numEntries, other.numEntries);
+    std::swap(namesSize, other.namesSize);
+    std::swap(numSlots, other.numSlots);
+    std::swap(numUsedSlots, other.numUsedSlots);
+    std::swap(numFiles, other.numFiles);
+
+    //a short name pool can be moved by the swap
+    if(! indexFile){
+        updateData();
+    }
+    if(! other.indexFile){
+        other.updateData();
+    }
+}
+
+bool FileInfoIndex::save(const std::string& indexFileName, const ZipFileStamp& stamp) const
+{
+    IndexFileHeader header = createHeader(sizeof(Entry), stamp);
+    header.numEntries = numEntries;
+    header.namesSize = namesSize;
+    header.numSlots = numSlots;
+    header.numUsedSlots = numUsedSlots;
+    header.numFiles = numFiles;
+
+    try {
+        boost::filesystem::path indexFilePath(indexFileName);
+        boost::filesystem::path tempFilePath = indexFilePath;
+        tempFilePath += boost::filesystem::unique_path(".%%%%-%%%%-%%%%");
+
+        {
+            boost::filesystem::ofstream fs(tempFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if(! fs.is_open()){
+                return false;
+            }
+
+            fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            fs.write(reinterpret_cast<const char*>(entryData),
+                     static_cast<std::streamsize>(numEntries * sizeof(Entry)));
+            fs.write(reinterpret_cast<const char*>(slotData),
+                     static_cast<std::streamsize>(numSlots * sizeof(unsigned int)));
+            fs.write(nameData, static_cast<std::streamsize>(namesSize));
+            fs.close();
+
+            if(fs.fail()){
+                boost::filesystem::remove(tempFilePath);
+                return false;
+            }
+        }
+
+        boost::filesystem::rename(tempFilePath, indexFilePath);
+    } catch (boost::filesystem::filesystem_error& e) {
+        return false;
+    }
+
+    return true;
+}
+
+bool FileInfoIndex::load(const std::string& indexFileName, const ZipFileStamp& stamp)
+{
+    std::shared_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile());
+    if(! mappedFile->open(indexFileName) || mappedFile->getSize() < sizeof(IndexFileHeader)){
+        return false;
+    }
+
+    IndexFileHeader header;
+    std::memcpy(&header, mappedFile->getData(), sizeof(header));
+
+    IndexFileHeader expectedHeader = createHeader(sizeof(Entry), stamp);
+    if(std::memcmp(header.magic, expectedHeader.magic, sizeof(header.magic)) != 0 ||
+       header.version != expectedHeader.version ||
+       header.byteOrder != expectedHeader.byteOrder ||
+       header.entrySize != expectedHeader.entrySize ||
+       ! (header.stamp == stamp))
+    {
+        return false;
+    }
+
+    //the hash table needs a power of two of slots and at least one empty slot
+    bool validSlots = header.numSlots == 0
+            ? header.numEntries == 0
+            : (header.numSlots & (header.numSlots - 1)) == 0 && header.numUsedSlots < header.numSlots;
+
+    unsigned long long expectedSize = sizeof(IndexFileHeader) +
+                                      header.numEntries * sizeof(Entry) +
+                                      header.numSlots * sizeof(unsigned int) +
+                                      header.namesSize;
+
+    if(! validSlots || header.numFiles > header.numEntries || mappedFile->getSize() != expectedSize){
+        return false;
+    }
+
+    clear();
+
+    const unsigned char* data = mappedFile->getData() + sizeof(IndexFileHeader);
+    entryData = reinterpret_cast<const Entry*>(data);
+    slotData = reinterpret_cast<const unsigned int*>(data + header.numEntries * sizeof(Entry));
+    nameData = reinterpret_cast<const char*>(data + header.numEntries * sizeof(Entry) +
+                                             header.numSlots * sizeof(unsigned int));
+
+    numEntries = static_cast<size_t>(header.numEntries);
+    namesSize = static_cast<size_t>(header.namesSize);
+    numSlots = static_cast<size_t>(header.numSlots);
+    numUsedSlots = static_cast<size_t>(header.numUsedSlots);
+    numFiles = static_cast<size_t>(header.numFiles);
+    indexFile = mappedFile;
+
+    return true;
+}
+
+size_t FileInfoIndex::findSlot(const std::string& fileName, unsigned int hash) const
+{
+    //the number of slots is a power of two and never full, except in a broken index file
+    size_t mask = numSlots - 1;
+    size_t slot = hash & mask;
+
+    //a broken index file ends the search after all slots
+    for(size_t i = 0; i < numSlots; ++i){
+        unsigned int entry = slotData[slot];
+        if(entry == 0 || (entry <= numEntries && isEntry(entryData[entry - 1], fileName, hash))){
+            return slot;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return numSlots;
+}
+
+bool FileInfoIndex::isEntry(const Entry& entry, const std::string& fileName, unsigned int hash) const
+{
+    return ! entry.erased &&
+           entry.hash == hash &&
+           entry.nameLength == fileName.size() &&
+           hasValidName(entry) &&
+           fileName.compare(0, fileName.size(), nameData + entry.nameOffset, entry.nameLength) == 0;
+}
+
+bool FileInfoIndex::hasValidName(const Entry& entry) const
+{
+    return entry.nameOffset <= namesSize && entry.nameLength <= namesSize - entry.nameOffset;
+}
+
+void FileInfoIndex::rehash(size_t numSlots)
+{
+    //the slots of erased entries are dropped
+    slots.assign(numSlots, 0);
+    numUsedSlots = 0;
+
+    size_t mask = numSlots - 1;
+    for(size_t i = 0; i < entries.size(); ++i){
+        if(entries[i].erased){
+            continue;
+        }
+
+        size_t slot = entries[i].hash & mask;
+        while(slots[slot] != 0){
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = static_cast<unsigned int>(i + 1);
+        ++numUsedSlots;
+    }
+}
+
+void FileInfoIndex::detach()
+{
+    if(! indexFile){
+        return;
+    }
+
+    entries.assign(entryData, entryData + numEntries);
+    names.assign(nameData, namesSize);
+    slots.assign(slotData, slotData + numSlots);
+    indexFile.reset();
+
+    updateData();
+}
+
+void FileInfoIndex::updateData()
+{
+    entryData = entries.data();
+    nameData = names.data();
+    slotData = slots.data();
+    numEntries = entries.size();
+    namesSize = names.size();
+    numSlots = slots.size();
+}
+
+} //cppzip
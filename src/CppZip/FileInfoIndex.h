@@ -0,0 +1,265 @@
+/*
+ * FileInfoIndex.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_FILEINFOINDEX_H_
+#define CPPZIP_FILEINFOINDEX_H_
+
+#include "CppZip_Global.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cppzip {
+
+//forward declaration
+class MemoryMappedFile;
+
+/*!
+ * \brief The informations of a file inside a zip, as kept in a FileInfoIndex.
+ *
+ * The record has a fixed size. The file name is kept in the name pool of the
+ * index, the extra field and the comment are not kept at all.
+ */
+struct CPPZIP_SHARED_EXPORT FileInfoRecord
+{
+    FileInfoRecord();
+
+    unsigned long long posInZipDirectory;     /* offset of the entry in the central directory (unz64_file_pos) */
+    unsigned long long numOfFile;             /* index of the entry in the central directory (unz64_file_pos) */
+    unsigned long long compressedSize;
+    unsigned long long uncompressedSize;
+    unsigned long long localHeaderOffset;     /* real position of the local header in the zip file */
+    unsigned int crc;                         /* crc-32 */
+    unsigned int dosDate;
+    unsigned int externalAttributes;
+    unsigned short internalAttributes;
+    unsigned short method;                    /* compression method */
+    unsigned short flag;                      /* general purpose bit flag */
+};
+
+/*!
+ * \brief Identifies the state of a zip file, an index file is saved for.
+ */
+struct CPPZIP_SHARED_EXPORT ZipFileStamp
+{
+    ZipFileStamp();
+
+    bool operator==(const ZipFileStamp& other) const;
+
+    unsigned long long fileSize;
+    long long modificationTime;               /* seconds since the epoch */
+    unsigned long long numEntries;            /* of the end of central directory record */
+    unsigned long long centralDirectoryOffset;
+    unsigned long long centralDirectorySize;
+    unsigned int endRecordCrc;                /* crc-32 of the end of central directory record incl. comment */
+    unsigned int reserved;
+};
+
+/*!
+ * \brief Reads the stamp of the zip file given in zipFileName.
+ *
+ * Only the end of the central directory is read.
+ *
+ * \return true if the stamp could be read, otherwise false.
+ */
+CPPZIP_SHARED_EXPORT bool readZipFileStamp(const std::string& zipFileName, ZipFileStamp& stamp);
+
+/*!
+ * \brief A compact index of the files inside a zip.
+ *
+ * The records are stored one after another in the order they are inserted,
+ * all file names are stored in one string pool. The names are found with an
+ * open addressing hash table (linear probing) that only holds the positions
+ * of the records. So an index with many files needs only a few allocations.
+ *
+ * Erased records stay in the pool until clear() is called.
+ *
+ * The records, the hash table and the pool can be saved as they are into an
+ * index file. load() maps the index file into memory and uses it directly,
+ * so loading takes the same time regardless of the number of files. The
+ * index file can only be read on the same platform, on others it doesn't
+ * match and has to be created again.
+ */
+class CPPZIP_SHARED_EXPORT FileInfoIndex
+{
+public:
+    FileInfoIndex();
+
+    /*!
+     * \brief Reserves the memory for numFiles files with namesSize bytes of names.
+     */
+    void reserve(size_t numFiles, size_t namesSize = 0);
+
+    /*!
+     * \brief Inserts the record of fileName.
+     *
+     * \return true if fileName was inserted, false if the index already contains
+     *         fileName. Then the existing record is kept.
+     */
+    bool insert(const std::string& fileName, const FileInfoRecord& record = FileInfoRecord());
+
+    /*!
+     * \brief Finds the record of fileName.
+     *
+     * \return the record or NULL, if the index doesn't contain fileName. The
+     *         pointer is valid until the index is changed.
+     */
+    const FileInfoRecord* find(const std::string& fileName) const;
+
+    /*!
+     * \brief Checks if the index contains fileName.
+     */
+    bool contains(const std::string& fileName) const;
+
+    /*!
+     * \brief Erases the record of fileName.
+     *
+     * \return true if fileName was erased, false if the index doesn't contain it.
+     */
+    bool erase(const std::string& fileName);
+
+    /*!
+     * \brief Gets the number of files in the index.
+     */
+    size_t size() const;
+
+    /*!
+     * \brief Checks if the index is empty.
+     */
+    bool empty() const;
+
+    /*!
+     * \brief Removes all files and frees the memory.
+     */
+    void clear();
+
+    /*!
+     * \brief Swaps the files with the files of other.
+     */
+    void swap(FileInfoIndex& other);
+
+    /*!
+     * \brief Saves the index into the index file given in indexFileName.
+     *
+     * The index file is written under a temporary name first and then renamed,
+     * so other processes see either the old or the new index file.
+     *
+     * \param stamp is the stamp of the zip file the index belongs to.
+     *
+     * \return true if the index file is written, otherwise false.
+     */
+    bool save(const std::string& indexFileName, const ZipFileStamp& stamp) const;
+
+    /*!
+     * \brief Loads the index from the index file given in indexFileName.
+     *
+     * The index file is mapped into memory. It is only copied, if the index
+     * is changed afterwards.
+     *
+     * \param stamp is the stamp of the zip file, the index file has to be saved for.
+     *
+     * \return true if the index is loaded, otherwise false (the index is unchanged).
+     */
+    bool load(const std::string& indexFileName, const ZipFileStamp& stamp);
+
+    /*!
+     * \brief Calls function(fileName, record) for each file in the order of insertion.
+     */
+    template<typename Function>
+    void forEach(Function function) const
+    {
+        std::string fileName;
+        for(size_t i = 0; i < numEntries; ++i){
+            const Entry& entry = entryData[i];
+            if(entry.erased || ! hasValidName(entry)){
+                continue;
+            }
+
+            fileName.assign(nameData + entry.nameOffset, entry.nameLength);
+            function(static_cast<const std::string&>(fileName), entry.record);
+        }
+    }
+
+private:
+    FileInfoIndex(const FileInfoIndex&);
+    FileInfoIndex& operator=(const FileInfoIndex&);
+
+    /*
+     * The layout is saved as it is into the index file.
+     */
+    struct Entry
+    {
+        FileInfoRecord record;
+        unsigned long long nameOffset;        /* position of the name in the pool */
+        unsigned int nameLength;
+        unsigned int hash;
+        unsigned int erased;
+    };
+
+    size_t findSlot(const std::string& fileName, unsigned int hash) const;
+    bool isEntry(const Entry& entry, const std::string& fileName, unsigned int hash) const;
+    bool hasValidName(const Entry& entry) const;
+    void rehash(size_t numSlots);
+
+    /*
+     * Copies a loaded index file into the own memory, before the index is changed.
+     */
+    void detach();
+
+    /*
+     * Points the data pointers to the own memory.
+     */
+    void updateData();
+
+private:
+    std::vector<Entry> entries;
+    std::string names;                        /* the pool with all file names */
+    std::vector<unsigned int> slots;          /* index of the entry + 1, 0 if empty */
+    std::shared_ptr<MemoryMappedFile> indexFile;  /* the loaded index file, if the data is in there */
+
+    const Entry* entryData;                   /* the data of entries, names and slots or of the index file */
+    const char* nameData;
+    const unsigned int* slotData;
+    size_t numEntries;                        /* incl. the erased entries */
+    size_t namesSize;
+    size_t numSlots;
+
+    size_t numUsedSlots;                      /* incl. the slots of erased entries */
+    size_t numFiles;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_FILEINFOINDEX_H_ */
@@ -0,0 +1,162 @@
+/*
+ * InflaterPool.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "InflaterPool.h"
+
+namespace cppzip {
+
+namespace {
+
+void endInflater(z_stream* stream)
+{
+    inflateEnd(stream);
+    delete stream;
+}
+
+} //anonymous namespace
+
+InflaterPool& InflaterPool::getInstance()
+{
+    //never destroyed: readers may still release into it while static objects are destroyed
+    static InflaterPool* instance = new InflaterPool();
+    return *instance;
+}
+
+InflaterPool::InflaterPool(size_t maxPooled)
+    : maxPooled(maxPooled)
+{
+
+}
+
+InflaterPool::~InflaterPool()
+{
+    for(auto stream : inflaters){
+        endInflater(stream);
+    }
+
+    for(auto buffer : buffers){
+        delete buffer;
+    }
+}
+
+std::shared_ptr<z_stream> InflaterPool::acquireInflater()
+{
+    z_stream* stream = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(! inflaters.empty()){
+            stream = inflaters.back();
+            inflaters.pop_back();
+        }
+    }
+
+    if(stream == NULL){
+        stream = new z_stream();
+        stream->zalloc = Z_NULL;
+        stream->zfree = Z_NULL;
+        stream->opaque = Z_NULL;
+        stream->next_in = Z_NULL;
+        stream->avail_in = 0;
+
+        if(Z_OK != inflateInit2(stream, -MAX_WBITS)){
+            delete stream;
+            return std::shared_ptr<z_stream>();
+        }
+    }
+
+    return std::shared_ptr<z_stream>(stream, [this](z_stream* stream){ releaseInflater(stream); });
+}
+
+std::shared_ptr<InflaterPool::Buffer> InflaterPool::acquireBuffer()
+{
+    Buffer* buffer = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(! buffers.empty()){
+            buffer = buffers.back();
+            buffers.pop_back();
+        }
+    }
+
+    if(buffer == NULL){
+        buffer = new Buffer(CPPZIP_INFLATER_POOL_BUFFER_SIZE);
+    }
+
+    return std::shared_ptr<Buffer>(buffer, [this](Buffer* buffer){ releaseBuffer(buffer); });
+}
+
+size_t InflaterPool::getNumPooledInflaters()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return inflaters.size();
+}
+
+size_t InflaterPool::getNumPooledBuffers()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return buffers.size();
+}
+
+void InflaterPool::releaseInflater(z_stream* stream)
+{
+    //also a stream that stopped with an error can be reset
+    if(Z_OK == inflateReset(stream)){
+        stream->next_in = Z_NULL;
+        stream->avail_in = 0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(inflaters.size() < maxPooled){
+            inflaters.push_back(stream);
+            return;
+        }
+    }
+
+    endInflater(stream);
+}
+
+void InflaterPool::releaseBuffer(Buffer* buffer)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(buffers.size() < maxPooled){
+            buffers.push_back(buffer);
+            return;
+        }
+    }
+
+    delete buffer;
+}
+
+} //cppzip
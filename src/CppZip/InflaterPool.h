@@ -0,0 +1,122 @@
+/*
+ * InflaterPool.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_INFLATERPOOL_H_
+#define CPPZIP_INFLATERPOOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <zlib.h>
+
+/*! \brief Maximum number of inflate states and of buffers kept by an InflaterPool. */
+#define CPPZIP_INFLATER_POOL_MAX_SIZE 64
+
+/*! \brief Size of the buffers handed out by an InflaterPool. */
+#define CPPZIP_INFLATER_POOL_BUFFER_SIZE 65536
+
+namespace cppzip {
+
+/*!
+ * \brief Keeps inflate states and read buffers to reuse them for the next file.
+ *
+ * inflateInit2() allocates the 32 KiB window and inflateEnd() frees it again,
+ * for zips with thousands of small files this is more work than the
+ * decompression itself. A released inflate state is reset with inflateReset()
+ * and handed out again by the next acquireInflater(). The buffers are reused
+ * the same way.
+ *
+ * The pool is thread safe. getInstance() is shared by all Unzip instances.
+ * Acquired objects are given back to the pool when their last shared_ptr is
+ * released, so the pool must outlive them.
+ */
+class InflaterPool
+{
+public:
+    typedef std::vector<unsigned char> Buffer;
+
+    /*!
+     * \brief Gets the pool shared by all Unzip instances, it lives until the program exits.
+     */
+    static InflaterPool& getInstance();
+
+    /*!
+     * \brief Creates a pool that keeps at most maxPooled inflate states and buffers.
+     */
+    explicit InflaterPool(size_t maxPooled = CPPZIP_INFLATER_POOL_MAX_SIZE);
+
+    /*!
+     * \brief Frees the pooled inflate states and buffers.
+     */
+    ~InflaterPool();
+
+    /*!
+     * \brief Gets an inflate state that is ready for a new raw deflate stream (no zlib header).
+     *
+     * \return the inflate state or an empty pointer if inflateInit2() failed.
+     */
+    std::shared_ptr<z_stream> acquireInflater();
+
+    /*!
+     * \brief Gets a buffer of CPPZIP_INFLATER_POOL_BUFFER_SIZE bytes.
+     */
+    std::shared_ptr<Buffer> acquireBuffer();
+
+    /*!
+     * \brief Gets the number of inflate states that wait in the pool.
+     */
+    size_t getNumPooledInflaters();
+
+    /*!
+     * \brief Gets the number of buffers that wait in the pool.
+     */
+    size_t getNumPooledBuffers();
+
+private:
+    InflaterPool(const InflaterPool&);
+    InflaterPool& operator=(const InflaterPool&);
+
+    void releaseInflater(z_stream* stream);
+    void releaseBuffer(Buffer* buffer);
+
+private:
+    std::mutex mutex;
+    std::vector<z_stream*> inflaters;
+    std::vector<Buffer*> buffers;
+    size_t maxPooled;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_INFLATERPOOL_H_ */
@@ -0,0 +1,208 @@
+/*
+ * MemoryIoApi.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "MemoryIoApi.h"
+
+#include <cstring>
+
+namespace cppzip {
+
+namespace {
+
+/*
+ * An opened file: the region (read-only) or the buffer and the own position.
+ */
+struct MemoryStream
+{
+    MemoryStream()
+        : region(NULL)
+        , buffer(NULL)
+        , position(0)
+        , error(0)
+    {}
+
+    const unsigned char* getData() const
+    {
+        return buffer != NULL ? buffer->data() : region->data;
+    }
+
+    unsigned long long getSize() const
+    {
+        return buffer != NULL ? buffer->size() : region->size;
+    }
+
+    const MemoryRegion* region;
+    std::vector<unsigned char>* buffer;
+    unsigned long long position;
+    int error;
+};
+
+voidpf ZCALLBACK regionOpen(voidpf opaque, const void* /*filename*/, int mode)
+{
+    //the region is read-only
+    if((mode & ZLIB_FILEFUNC_MODE_READWRITEFILTER) != ZLIB_FILEFUNC_MODE_READ){
+        return NULL;
+    }
+
+    MemoryStream* stream = new MemoryStream();
+    stream->region = static_cast<const MemoryRegion*>(opaque);
+
+    return stream;
+}
+
+voidpf ZCALLBACK bufferOpen(voidpf opaque, const void* /*filename*/, int mode)
+{
+    MemoryStream* stream = new MemoryStream();
+    stream->buffer = static_cast<std::vector<unsigned char>*>(opaque);
+
+    if(mode & ZLIB_FILEFUNC_MODE_CREATE){
+        stream->buffer->clear();
+    }
+
+    return stream;
+}
+
+uLong ZCALLBACK memoryRead(voidpf /*opaque*/, voidpf streamPtr, void* buf, uLong size)
+{
+    MemoryStream* stream = static_cast<MemoryStream*>(streamPtr);
+    unsigned long long streamSize = stream->getSize();
+
+    if(stream->position >= streamSize){
+        return 0;
+    }
+
+    unsigned long long available = streamSize - stream->position;
+    if(available < size){
+        size = static_cast<uLong>(available);
+    }
+
+    std::memcpy(buf, stream->getData() + stream->position, size);
+    stream->position += size;
+
+    return size;
+}
+
+uLong ZCALLBACK memoryWrite(voidpf /*opaque*/, voidpf streamPtr, const void* buf, uLong size)
+{
+    MemoryStream* stream = static_cast<MemoryStream*>(streamPtr);
+
+    if(stream->buffer == NULL){
+        stream->error = 1;
+        return 0;
+    }
+
+    //minizip also overwrites already written headers
+    unsigned long long end = stream->position + size;
+    if(end > stream->buffer->size()){
+        stream->buffer->resize(static_cast<size_t>(end));
+    }
+
+    if(size > 0){
+        std::memcpy(stream->buffer->data() + stream->position, buf, size);
+    }
+    stream->position = end;
+
+    return size;
+}
+
+ZPOS64_T ZCALLBACK memoryTell(voidpf /*opaque*/, voidpf streamPtr)
+{
+    return static_cast<MemoryStream*>(streamPtr)->position;
+}
+
+long ZCALLBACK memorySeek(voidpf /*opaque*/, voidpf streamPtr, ZPOS64_T offset, int origin)
+{
+    MemoryStream* stream = static_cast<MemoryStream*>(streamPtr);
+    unsigned long long newPosition = 0;
+
+    switch(origin){
+        case ZLIB_FILEFUNC_SEEK_CUR:
+            newPosition = stream->position + offset;
+            break;
+        case ZLIB_FILEFUNC_SEEK_END:
+            newPosition = stream->getSize() + offset;
+            break;
+        case ZLIB_FILEFUNC_SEEK_SET:
+            newPosition = offset;
+            break;
+        default:
+            return -1;
+    }
+
+    if(newPosition > stream->getSize()){
+        return -1;
+    }
+
+    stream->position = newPosition;
+
+    return 0;
+}
+
+int ZCALLBACK memoryClose(voidpf /*opaque*/, voidpf streamPtr)
+{
+    delete static_cast<MemoryStream*>(streamPtr);
+    return 0;
+}
+
+int ZCALLBACK memoryError(voidpf /*opaque*/, voidpf streamPtr)
+{
+    return static_cast<MemoryStream*>(streamPtr)->error;
+}
+
+} //anonymous namespace
+
+void fillMemoryFileFunc(zlib_filefunc64_def* filefunc, const MemoryRegion* region)
+{
+    filefunc->zopen64_file = regionOpen;
+    filefunc->zread_file = memoryRead;
+    filefunc->zwrite_file = memoryWrite;
+    filefunc->ztell64_file = memoryTell;
+    filefunc->zseek64_file = memorySeek;
+    filefunc->zclose_file = memoryClose;
+    filefunc->zerror_file = memoryError;
+    filefunc->opaque = const_cast<MemoryRegion*>(region);
+}
+
+void fillMemoryFileFunc(zlib_filefunc64_def* filefunc, std::vector<unsigned char>* buffer)
+{
+    filefunc->zopen64_file = bufferOpen;
+    filefunc->zread_file = memoryRead;
+    filefunc->zwrite_file = memoryWrite;
+    filefunc->ztell64_file = memoryTell;
+    filefunc->zseek64_file = memorySeek;
+    filefunc->zclose_file = memoryClose;
+    filefunc->zerror_file = memoryError;
+    filefunc->opaque = buffer;
+}
+
+} //cppzip
@@ -0,0 +1,88 @@
+/*
+ * MemoryIoApi.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_MEMORYIOAPI_H_
+#define CPPZIP_MEMORYIOAPI_H_
+
+#include <memory>
+#include <vector>
+
+#include "minizip/ioapi.h"
+
+namespace cppzip {
+
+/*!
+ * \brief A read-only memory region, that contains a whole zip file.
+ */
+struct MemoryRegion
+{
+    MemoryRegion(const unsigned char* data,
+                 unsigned long long size,
+                 std::shared_ptr<void> owner = std::shared_ptr<void>())
+        : data(data)
+        , size(size)
+        , owner(owner)
+    {}
+
+    const unsigned char* data;
+    unsigned long long size;
+    std::shared_ptr<void> owner;          /* keeps the memory alive (e.g. a MemoryMappedFile) */
+};
+
+/*!
+ * \brief Fills the minizip io functions to read a zip file from region.
+ *
+ * Every file opened with the functions has its own position, so several
+ * handles (e.g. of several threads) can read from the same region.
+ *
+ * \param filefunc is the structure to fill, to be used with unzOpen2_64().
+ * \param region is the memory to read from. It has to live longer than the
+ *               handles that are opened with filefunc.
+ */
+void fillMemoryFileFunc(zlib_filefunc64_def* filefunc, const MemoryRegion* region);
+
+/*!
+ * \brief Fills the minizip io functions to read and write a zip file in buffer.
+ *
+ * The buffer grows while the zip is written. When a file is opened to
+ * create a new zip, the buffer is cleared.
+ *
+ * \param filefunc is the structure to fill, to be used with zipOpen2_64() or unzOpen2_64().
+ * \param buffer is the memory to read from and write to. It has to live longer
+ *               than the handles that are opened with filefunc.
+ */
+void fillMemoryFileFunc(zlib_filefunc64_def* filefunc, std::vector<unsigned char>* buffer);
+
+} //cppzip
+
+#endif /* CPPZIP_MEMORYIOAPI_H_ */
@@ -0,0 +1,184 @@
+/*
+ * MemoryMappedFile.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "MemoryMappedFile.h"
+
+#ifndef WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#else
+    #include <windows.h>
+#endif
+
+namespace cppzip {
+
+MemoryMappedFile::MemoryMappedFile()
+    : data(NULL)
+    , size(0)
+#ifdef WIN32
+    , fileHandle(INVALID_HANDLE_VALUE)
+    , mappingHandle(NULL)
+#endif
+{
+
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+#ifndef WIN32
+
+bool MemoryMappedFile::open(const std::string& fileName)
+{
+    if(isOpened()){
+        return false;
+    }
+
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if(fd < 0){
+        return false;
+    }
+
+    struct stat fileStat;
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0){
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(NULL, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    //the mapping stays valid after the file descriptor is closed
+    ::close(fd);
+
+    if(mapped == MAP_FAILED){
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    size = static_cast<unsigned long long>(fileStat.st_size);
+
+    return true;
+}
+
+void MemoryMappedFile::close()
+{
+    if(! isOpened()){
+        return;
+    }
+
+    munmap(const_cast<unsigned char*>(data), static_cast<size_t>(size));
+    data = NULL;
+    size = 0;
+}
+
+#else
+
+bool MemoryMappedFile::open(const std::string& fileName)
+{
+    if(isOpened()){
+        return false;
+    }
+
+    fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(fileHandle == INVALID_HANDLE_VALUE){
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if(! GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0){
+        close();
+        return false;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mappingHandle == NULL){
+        close();
+        return false;
+    }
+
+    void* mapped = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if(mapped == NULL){
+        close();
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    size = static_cast<unsigned long long>(fileSize.QuadPart);
+
+    return true;
+}
+
+void MemoryMappedFile::close()
+{
+    if(data != NULL){
+        UnmapViewOfFile(data);
+    }
+
+    if(mappingHandle != NULL){
+        CloseHandle(mappingHandle);
+    }
+
+    if(fileHandle != INVALID_HANDLE_VALUE){
+        CloseHandle(fileHandle);
+    }
+
+    data = NULL;
+    size = 0;
+    mappingHandle = NULL;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#endif
+
+bool MemoryMappedFile::isOpened() const
+{
+    return data != NULL;
+}
+
+const unsigned char* MemoryMappedFile::getData() const
+{
+    return data;
+}
+
+unsigned long long MemoryMappedFile::getSize() const
+{
+    return size;
+}
+
+} //cppzip
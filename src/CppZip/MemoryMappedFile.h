@@ -0,0 +1,100 @@
+/*
+ * MemoryMappedFile.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_MEMORYMAPPEDFILE_H_
+#define CPPZIP_MEMORYMAPPEDFILE_H_
+
+#include <string>
+
+namespace cppzip {
+
+/*!
+ * \brief Maps a whole file read-only into memory.
+ *
+ * The content is read directly from the page cache, without read syscalls
+ * and without stdio buffering.
+ */
+class MemoryMappedFile
+{
+public:
+    MemoryMappedFile();
+
+    /*!
+     * \brief Unmaps the file.
+     */
+    ~MemoryMappedFile();
+
+    /*!
+     * \brief Maps the file given in fileName into memory.
+     *
+     * \return true if the file is mapped, otherwise false (also for empty files).
+     */
+    bool open(const std::string& fileName);
+
+    /*!
+     * \brief Unmaps the file.
+     */
+    void close();
+
+    /*!
+     * \brief Checks if a file is mapped.
+     */
+    bool isOpened() const;
+
+    /*!
+     * \brief Gets the mapped content of the file.
+     */
+    const unsigned char* getData() const;
+
+    /*!
+     * \brief Gets the size of the file.
+     */
+    unsigned long long getSize() const;
+
+private:
+    MemoryMappedFile(const MemoryMappedFile&);
+    MemoryMappedFile& operator=(const MemoryMappedFile&);
+
+private:
+    const unsigned char* data;
+    unsigned long long size;
+
+#ifdef WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+} //cppzip
+
+#endif /* CPPZIP_MEMORYMAPPEDFILE_H_ */
@@ -0,0 +1,250 @@
+/*
+ * ParallelDeflate.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "ParallelDeflate.h"
+#include "DeflaterPool.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <zlib.h>
+
+#define CPPZIP_DEFLATE_DICTIONARY_SIZE 32768
+
+namespace cppzip {
+
+namespace {
+
+typedef std::vector<unsigned char> Block;
+
+DeflatedData compressBlock(DeflaterPool& deflaterPool, int compressionLevel,
+                           const unsigned char* data, size_t length,
+                           const unsigned char* dictionary, size_t dictionaryLength,
+                           bool isLastBlock)
+{
+    DeflatedData result;
+    result.uncompressedSize = length;
+    result.crc = crc32(0L, data, static_cast<uInt>(length));
+
+    //the state comes reset from the pool and goes back to it at the end
+    std::shared_ptr<z_stream> deflater = deflaterPool.acquireDeflater(compressionLevel);
+    if(! deflater){
+        return result;
+    }
+
+    z_stream& stream = *deflater;
+
+    if(dictionaryLength > 0){
+        deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionaryLength));
+    }
+
+    //the sync flush marker needs some bytes more than deflateBound()
+    result.data.resize(deflateBound(&stream, static_cast<uLong>(length)) + 16);
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(length);
+    stream.next_out = result.data.data();
+    stream.avail_out = static_cast<uInt>(result.data.size());
+
+    int flush = isLastBlock ? Z_FINISH : Z_SYNC_FLUSH;
+    bool ok = true;
+
+    while(true){
+        if(stream.avail_out == 0){
+            size_t used = result.data.size();
+            result.data.resize(used * 2);
+            stream.next_out = result.data.data() + used;
+            stream.avail_out = static_cast<uInt>(result.data.size() - used);
+        }
+
+        int err = deflate(&stream, flush);
+        if(err == Z_STREAM_END){
+            break;
+        }
+
+        if((err != Z_OK && err != Z_BUF_ERROR) || (err == Z_BUF_ERROR && stream.avail_out != 0)){
+            ok = false;
+            break;
+        }
+
+        if(! isLastBlock && stream.avail_out != 0){ //sync flush is complete
+            break;
+        }
+    }
+
+    result.data.resize(result.data.size() - stream.avail_out);
+    result.dataType = stream.data_type;
+    result.ok = ok;
+
+    return result;
+}
+
+DeflatedData compressBlock(DeflaterPool& deflaterPool, int compressionLevel,
+                           std::shared_ptr<const Block> block,
+                           std::shared_ptr<const Block> previousBlock,
+                           bool isLastBlock)
+{
+    //prime the dictionary with the end of the previous block
+    size_t dictionaryLength = 0;
+    const unsigned char* dictionary = NULL;
+
+    if(previousBlock && ! previousBlock->empty()){
+        dictionaryLength = std::min(previousBlock->size(),
+                                    static_cast<size_t>(CPPZIP_DEFLATE_DICTIONARY_SIZE));
+        dictionary = previousBlock->data() + previousBlock->size() - dictionaryLength;
+    }
+
+    return compressBlock(deflaterPool, compressionLevel, block->data(), block->size(),
+                         dictionary, dictionaryLength, isLastBlock);
+}
+
+std::shared_ptr<Block> readBlock(std::istream& input, size_t blockSize)
+{
+    std::shared_ptr<Block> block(new Block(blockSize));
+
+    input.read(reinterpret_cast<char*>(block->data()), blockSize);
+    block->resize(static_cast<size_t>(input.gcount()));
+
+    return block;
+}
+
+} //anonymous namespace
+
+DeflatedData::DeflatedData()
+    : ok(false)
+    , crc(0)
+    , uncompressedSize(0)
+    , dataType(Z_BINARY)
+{
+
+}
+
+DeflatedData deflateData(int compressionLevel, const unsigned char* data, size_t length)
+{
+    return compressBlock(DeflaterPool::getInstance(), compressionLevel, data, length, NULL, 0, true);
+}
+
+ParallelDeflate::ParallelDeflate(ThreadPool& pool, int compressionLevel, size_t blockSize,
+                                 DeflaterPool& deflaterPool)
+    : pool(pool)
+    , deflaterPool(deflaterPool)
+    , compressionLevel(compressionLevel)
+    , blockSize(blockSize)
+    , crc(0)
+    , uncompressedSize(0)
+{
+
+}
+
+bool ParallelDeflate::compress(std::istream& input, const Writer& writer)
+{
+    crc = crc32(0L, Z_NULL, 0);
+    uncompressedSize = 0;
+
+    //limits the memory: only a few blocks per thread are in flight
+    const size_t maxBlocksInFlight = 2 * pool.getNumThreads();
+    std::deque<std::future<DeflatedData> > blocksInFlight;
+    bool ok = true;
+
+    auto writeNextBlock = [&]() {
+        DeflatedData compressed = blocksInFlight.front().get();
+        blocksInFlight.pop_front();
+
+        if(! ok || ! compressed.ok){
+            ok = false;
+            return;
+        }
+
+        crc = crc32_combine(crc, compressed.crc, static_cast<z_off_t>(compressed.uncompressedSize));
+        uncompressedSize += compressed.uncompressedSize;
+
+        if(! compressed.data.empty() &&
+           ! writer(compressed.data.data(), static_cast<unsigned int>(compressed.data.size()))){
+            ok = false;
+        }
+    };
+
+    std::shared_ptr<const Block> previousBlock;
+    std::shared_ptr<const Block> block = readBlock(input, blockSize);
+
+    //read one block ahead to know which block is the last one
+    while(ok){
+        std::shared_ptr<const Block> nextBlock;
+        if(input.good()){
+            nextBlock = readBlock(input, blockSize);
+        }
+
+        bool isLastBlock = ! nextBlock || nextBlock->empty();
+        int level = compressionLevel;
+        DeflaterPool* deflaters = &deflaterPool;
+
+        blocksInFlight.push_back(pool.submit([deflaters, level, block, previousBlock, isLastBlock](){
+            return compressBlock(*deflaters, level, block, previousBlock, isLastBlock);
+        }));
+
+        while(blocksInFlight.size() >= maxBlocksInFlight && ok){
+            writeNextBlock();
+        }
+
+        if(isLastBlock){
+            break;
+        }
+
+        previousBlock = block;
+        block = nextBlock;
+    }
+
+    //also wait for the remaining blocks on errors, they reference the blocks
+    while(! blocksInFlight.empty()){
+        writeNextBlock();
+    }
+
+    if(input.bad()){
+        ok = false;
+    }
+
+    return ok;
+}
+
+unsigned long ParallelDeflate::getCrc() const
+{
+    return crc;
+}
+
+unsigned long long ParallelDeflate::getUncompressedSize() const
+{
+    return uncompressedSize;
+}
+
+} //cppzip
@@ -0,0 +1,133 @@
+/*
+ * ParallelDeflate.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_PARALLELDEFLATE_H_
+#define CPPZIP_PARALLELDEFLATE_H_
+
+#include "DeflaterPool.h"
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <vector>
+
+/*! \brief Size of the blocks that are compressed independently (like pigz). */
+#define CPPZIP_PARALLEL_DEFLATE_BLOCK_SIZE 131072
+
+namespace cppzip {
+
+//forward declaration
+class ThreadPool;
+
+/*!
+ * \brief Raw deflate data together with the informations needed to write it into a zip.
+ */
+struct DeflatedData
+{
+    DeflatedData();
+
+    bool ok;                                  /* true if the data could be compressed */
+    std::vector<unsigned char> data;          /* the raw deflate data */
+    unsigned long crc;                        /* crc-32 of the uncompressed data */
+    unsigned long long uncompressedSize;      /* size of the uncompressed data */
+    int dataType;                             /* Z_BINARY or Z_TEXT, detected by deflate */
+};
+
+/*!
+ * \brief Compresses data in one piece into a finished raw deflate stream.
+ *
+ * The stream is compressed with the same parameters as minizip uses, so the
+ * result is the same as when data is written with zipWriteInFileInZip().
+ * The deflate state is taken from DeflaterPool::getInstance().
+ *
+ * \param compressionLevel is the level of compression (0-9).
+ * \param data is the data to compress.
+ * \param length is the length of data.
+ *
+ * \return the compressed data.
+ */
+DeflatedData deflateData(int compressionLevel, const unsigned char* data, size_t length);
+
+/*!
+ * \brief Compresses a stream with several threads into one raw deflate stream.
+ *
+ * The input is split into blocks of blockSize bytes. Each block is compressed
+ * in a worker thread of the pool with the last 32 KiB of the previous block as
+ * dictionary and ends with a sync flush, so the blocks can be concatenated.
+ * The last block is finished with Z_FINISH. The result is one standard deflate
+ * stream, readable by every unzip tool. The crc-32 of the whole input is
+ * calculated with crc32_combine() from the crc's of the blocks. The workers
+ * take their deflate states from deflaterPool, so a state is reused for the
+ * next block instead of being initialized for each block.
+ */
+class ParallelDeflate
+{
+public:
+    /*!
+     * \brief Writes a compressed block in the order of the input.
+     *
+     * \return true if the block could be written, otherwise false.
+     */
+    typedef std::function<bool (const unsigned char* data, unsigned int length)> Writer;
+
+    ParallelDeflate(ThreadPool& pool, int compressionLevel,
+                    size_t blockSize = CPPZIP_PARALLEL_DEFLATE_BLOCK_SIZE,
+                    DeflaterPool& deflaterPool = DeflaterPool::getInstance());
+
+    /*!
+     * \brief Compresses input and hands the compressed data to writer.
+     *
+     * \return true if the whole input could be compressed and written, otherwise false.
+     */
+    bool compress(std::istream& input, const Writer& writer);
+
+    /*! \brief Gets the crc-32 of the uncompressed data. */
+    unsigned long getCrc() const;
+
+    /*! \brief Gets the size of the uncompressed data. */
+    unsigned long long getUncompressedSize() const;
+
+private:
+    ThreadPool& pool;
+    DeflaterPool& deflaterPool;
+    int compressionLevel;
+    size_t blockSize;
+
+    unsigned long crc;
+    unsigned long long uncompressedSize;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_PARALLELDEFLATE_H_ */
@@ -0,0 +1,171 @@
+/*
+ * PositionalFile.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "PositionalFile.h"
+
+#ifndef WIN32
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#else
+    #include <windows.h>
+#endif
+
+namespace cppzip {
+
+#ifndef WIN32
+
+PositionalFile::PositionalFile()
+    : fd(-1)
+{
+
+}
+
+#else
+
+PositionalFile::PositionalFile()
+    : fileHandle(INVALID_HANDLE_VALUE)
+{
+
+}
+
+#endif
+
+PositionalFile::~PositionalFile()
+{
+    close();
+}
+
+#ifndef WIN32
+
+bool PositionalFile::open(const std::string& fileName)
+{
+    if(isOpened()){
+        return false;
+    }
+
+    fd = ::open(fileName.c_str(), O_RDONLY);
+
+    return isOpened();
+}
+
+void PositionalFile::close()
+{
+    if(! isOpened()){
+        return;
+    }
+
+    ::close(fd);
+    fd = -1;
+}
+
+bool PositionalFile::isOpened() const
+{
+    return fd >= 0;
+}
+
+bool PositionalFile::readAt(unsigned long long offset, unsigned char* buffer, size_t length) const
+{
+    while(length > 0){
+        ssize_t numRead = pread(fd, buffer, length, static_cast<off_t>(offset));
+        if(numRead < 0 && errno == EINTR){
+            continue;
+        }
+
+        if(numRead <= 0){ //error or end of file
+            return false;
+        }
+
+        buffer += numRead;
+        offset += static_cast<unsigned long long>(numRead);
+        length -= static_cast<size_t>(numRead);
+    }
+
+    return true;
+}
+
+#else
+
+bool PositionalFile::open(const std::string& fileName)
+{
+    if(isOpened()){
+        return false;
+    }
+
+    fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    return isOpened();
+}
+
+void PositionalFile::close()
+{
+    if(! isOpened()){
+        return;
+    }
+
+    CloseHandle(fileHandle);
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+bool PositionalFile::isOpened() const
+{
+    return fileHandle != INVALID_HANDLE_VALUE;
+}
+
+bool PositionalFile::readAt(unsigned long long offset, unsigned char* buffer, size_t length) const
+{
+    while(length > 0){
+        //the offset of the OVERLAPPED structure is used also for synchronous handles
+        OVERLAPPED overlapped = OVERLAPPED();
+        overlapped.Offset = static_cast<DWORD>(offset & 0xffffffff);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+        DWORD toRead = length > 0x40000000 ? 0x40000000 : static_cast<DWORD>(length);
+        DWORD numRead = 0;
+        if(! ReadFile(fileHandle, buffer, toRead, &numRead, &overlapped) || numRead == 0){
+            return false;
+        }
+
+        buffer += numRead;
+        offset += numRead;
+        length -= numRead;
+    }
+
+    return true;
+}
+
+#endif
+
+} //cppzip
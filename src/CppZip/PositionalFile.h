@@ -0,0 +1,97 @@
+/*
+ * PositionalFile.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_POSITIONALFILE_H_
+#define CPPZIP_POSITIONALFILE_H_
+
+#include <cstddef>
+#include <string>
+
+namespace cppzip {
+
+/*!
+ * \brief A file opened read-only, that is read at given positions.
+ *
+ * The file has no current position, each read tells where to read (pread on
+ * POSIX, ReadFile with an OVERLAPPED offset on Windows). So several threads
+ * can read from the same PositionalFile at the same time.
+ */
+class PositionalFile
+{
+public:
+    PositionalFile();
+
+    /*!
+     * \brief Closes the file.
+     */
+    ~PositionalFile();
+
+    /*!
+     * \brief Opens the file given in fileName.
+     *
+     * \return true if the file is opened, otherwise false.
+     */
+    bool open(const std::string& fileName);
+
+    /*!
+     * \brief Closes the file.
+     */
+    void close();
+
+    /*!
+     * \brief Checks if a file is opened.
+     */
+    bool isOpened() const;
+
+    /*!
+     * \brief Reads length bytes at offset into buffer.
+     *
+     * \return true if all bytes could be read, otherwise false.
+     */
+    bool readAt(unsigned long long offset, unsigned char* buffer, size_t length) const;
+
+private:
+    PositionalFile(const PositionalFile&);
+    PositionalFile& operator=(const PositionalFile&);
+
+private:
+#ifndef WIN32
+    int fd;
+#else
+    void* fileHandle;
+#endif
+};
+
+} //cppzip
+
+#endif /* CPPZIP_POSITIONALFILE_H_ */
@@ -0,0 +1,98 @@
+/*
+ * ThreadPool.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "ThreadPool.h"
+
+namespace cppzip {
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : stopping(false)
+{
+    if(numThreads == 0){
+        numThreads = 1;
+    }
+
+    for(unsigned int i = 0; i < numThreads; ++i){
+        workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for(auto& worker : workers){
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::getNumThreads() const
+{
+    return static_cast<unsigned int>(workers.size());
+}
+
+void ThreadPool::enqueue(const std::function<void()>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+    condition.notify_one();
+}
+
+void ThreadPool::work()
+{
+    while(true){
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this](){ return stopping || ! tasks.empty(); });
+
+            if(tasks.empty()){ //stopping and nothing left to do
+                return;
+            }
+
+            task = tasks.front();
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+} //cppzip
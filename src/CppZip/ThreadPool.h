@@ -0,0 +1,111 @@
+/*
+ * ThreadPool.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_THREADPOOL_H_
+#define CPPZIP_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cppzip {
+
+/*!
+ * \brief A small fixed size pool of worker threads.
+ *
+ * The tasks are executed in the order they are submitted. The result of a task
+ * is delivered through the returned std::future, so the caller can collect the
+ * results in submission order.
+ */
+class ThreadPool
+{
+public:
+    /*!
+     * \brief Starts numThreads worker threads (at least one).
+     */
+    explicit ThreadPool(unsigned int numThreads);
+
+    /*!
+     * \brief Waits until all submitted tasks are done and stops the workers.
+     */
+    ~ThreadPool();
+
+    /*!
+     * \brief Gets the number of worker threads.
+     */
+    unsigned int getNumThreads() const;
+
+    /*!
+     * \brief Submits a task to the pool.
+     *
+     * \param task is the function to execute in a worker thread.
+     *
+     * \return the future that holds the result of the task.
+     */
+    template<typename Task>
+    std::future<typename std::result_of<Task()>::type> submit(Task task)
+    {
+        typedef typename std::result_of<Task()>::type Result;
+
+        std::shared_ptr<std::packaged_task<Result()> > packagedTask(
+                new std::packaged_task<Result()>(task));
+        std::future<Result> result = packagedTask->get_future();
+
+        enqueue([packagedTask](){ (*packagedTask)(); });
+
+        return result;
+    }
+
+private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    void enqueue(const std::function<void()>& task);
+    void work();
+
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()> > tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_THREADPOOL_H_ */
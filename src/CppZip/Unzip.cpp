@@ -6,12 +6,23 @@
  */
 
 #include "Unzip.h"
+#include "UnzipFileReader.h"
+#include "CheckpointIndex.h"
+#include "EntryReader.h"
+#include "InflaterPool.h"
+#include "MemoryIoApi.h"
+#include "MemoryMappedFile.h"
+#include "PositionalFile.h"
 #include "ZipCommon.h"
 #include "ZipPrivate.h"
 #include "minizip/unzip.h"
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
 #include <fstream>
+#include <thread>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/algorithm/string.hpp>
@@ -20,6 +31,54 @@
 
 namespace cppzip {
 
+namespace {
+
+/*
+ * Creates the positional reads of the zip file or of the zip in memory.
+ */
+ReadAt createReadAt(const std::string& zipFileName, std::shared_ptr<MemoryRegion> memoryRegion)
+{
+    if(memoryRegion){
+        return [memoryRegion](unsigned long long offset, unsigned char* data, size_t length){
+            if(offset > memoryRegion->size || length > memoryRegion->size - offset){
+                return false;
+            }
+            std::memcpy(data, memoryRegion->data + offset, length);
+            return true;
+        };
+    }
+
+    std::shared_ptr<PositionalFile> file(new PositionalFile());
+    if(! file->open(zipFileName)){
+        return ReadAt();
+    }
+
+    return [file](unsigned long long offset, unsigned char* data, size_t length){
+        return file->readAt(offset, data, length);
+    };
+}
+
+std::shared_ptr<const CheckpointIndex> findCheckpointIndex(UnzipPrivate* p, const std::string& fileName)
+{
+    std::lock_guard<std::mutex> lock(p->checkpointIndexesMutex);
+
+    auto found = p->checkpointIndexes.find(fileName);
+    if(found == p->checkpointIndexes.end()){
+        return std::shared_ptr<const CheckpointIndex>();
+    }
+
+    return found->second;
+}
+
+void addCheckpointIndex(UnzipPrivate* p, const std::string& fileName,
+                        std::shared_ptr<const CheckpointIndex> checkpointIndex)
+{
+    std::lock_guard<std::mutex> lock(p->checkpointIndexesMutex);
+    p->checkpointIndexes[fileName] = checkpointIndex;
+}
+
+} //anonymous namespace
+
 Unzip::Unzip()
 : p(new UnzipPrivate())
 {
@@ -33,23 +92,72 @@ Unzip::~Unzip()
     p = NULL;
 }
 
-bool Unzip::open(const std::string& zipFile, const std::string& password)
+bool Unzip::open(const std::string& zipFile,
+                 const std::string& password,
+                 const ReadModes::Modes& readMode)
 {
     if(isOpened()){ //if already opened, don't open a file
         return false;
     }
 
-    this->p->zipfile_handle = unzOpen(zipFile.c_str());
+    if(readMode == ReadModes::MemoryMapped){
+        std::shared_ptr<MemoryMappedFile> mappedFile(new MemoryMappedFile());
+        if(! mappedFile->open(zipFile)){
+            return false;
+        }
+
+        this->p->memoryRegion.reset(new MemoryRegion(mappedFile->getData(),
+                                                     mappedFile->getSize(),
+                                                     mappedFile));
+    }
+
+    this->p->zipFileName = zipFile;
+
+    return open_internal(password);
+}
+
+bool Unzip::open(const unsigned char* data, size_t size, const std::string& password)
+{
+    if(isOpened()){ //if already opened, don't open a file
+        return false;
+    }
+
+    this->p->memoryRegion.reset(new MemoryRegion(data, size));
+
+    return open_internal(password);
+}
+
+bool Unzip::open_internal(const std::string& password)
+{
+    this->p->zipfile_handle = openHandle();
     this->p->password = password;
 
     if(isOpened()){
         getGlobalInfo();
-        retrieveAllFileInfos();
+        this->p->readAt = createReadAt(this->p->zipFileName, this->p->memoryRegion);
+
+        if(this->p->indexMode != IndexModes::Lazy){
+            retrieveAllFileInfosIfNeeded();
+        }
+    } else {
+        clear();
     }
 
     return isOpened();
 }
 
+void* Unzip::openHandle()
+{
+    if(this->p->memoryRegion){
+        zlib_filefunc64_def filefunc;
+        fillMemoryFileFunc(&filefunc, this->p->memoryRegion.get());
+
+        return unzOpen2_64(this->p->zipFileName.c_str(), &filefunc);
+    }
+
+    return unzOpen64(this->p->zipFileName.c_str());
+}
+
 bool Unzip::close()
 {
     if(! isOpened()){
@@ -69,6 +177,11 @@ void Unzip::clear()
     this->p->numFiles = 0;
     this->p->zipfile_handle = NULL;
     this->p->fileInfos.clear();
+    this->p->fileInfosRetrieved = false;
+    this->p->readAt = ReadAt();
+    this->p->checkpointIndexes.clear();
+    this->p->zipFileName.clear();
+    this->p->memoryRegion.reset();
 }
 
 bool Unzip::isOpened()
@@ -93,9 +206,36 @@ std::list<std::string> Unzip::getFileNames()
 {
     std::list<std::string> fileNames;
 
-    for(const auto& iter : this->p->fileInfos) {
-        const std::string& fileName = iter.first;
+    retrieveAllFileInfosIfNeeded();
+
+    this->p->fileInfos.forEach([&](const std::string& fileName, const FileInfoRecord&){
         fileNames.push_back(fileName);
+    });
+
+    return fileNames;
+}
+
+std::list<std::string> Unzip::getFileNamesInZipOrder()
+{
+    std::vector<std::pair<unsigned long long, std::string> > files;
+
+    retrieveAllFileInfosIfNeeded();
+
+    files.reserve(this->p->fileInfos.size());
+    this->p->fileInfos.forEach([&](const std::string& fileName, const FileInfoRecord& info){
+        files.push_back(std::make_pair(info.localHeaderOffset, fileName));
+    });
+
+    //stable: keeps the order of the central directory for equal positions
+    std::stable_sort(files.begin(), files.end(),
+                     [](const std::pair<unsigned long long, std::string>& a,
+                        const std::pair<unsigned long long, std::string>& b){
+        return a.first < b.first;
+    });
+
+    std::list<std::string> fileNames;
+    for(const auto& file : files){
+        fileNames.push_back(file.second);
     }
 
     return fileNames;
@@ -105,12 +245,30 @@ std::vector<unsigned char> Unzip::getFileContent(const std::string& fileName)
 {
     std::vector<unsigned char> fileContent;
 
-    if(this->p->fileInfos.count(fileName) == 0){
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL){
         return fileContent;
     }
 
+    //read content directly into the preallocated vector
+    fileContent.resize(static_cast<size_t>(info->uncompressedSize));
+
+    if(this->p->readAt && EntryReader::canRead(*info)){
+        EntryReader reader(this->p->readAt);
+        if(! reader.open(*info) || ! reader.readAll(fileContent.data())){
+            fileContent.clear();
+        }
+
+        return fileContent;
+    }
+
+    std::lock_guard<std::mutex> lock(this->p->handleMutex);
+
     //locate file
     if(! goToFile(fileName)){
+        fileContent.clear();
         return fileContent;
     }
 
@@ -119,53 +277,432 @@ std::vector<unsigned char> Unzip::getFileContent(const std::string& fileName)
                                      NULL, NULL, 0,
                                      formatPassword(this->p->password)))
     {
+        fileContent.clear();
         return fileContent;
     }
 
-    //read content
-    unsigned char buffer[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
+    //the content must have the size of the central directory, like with EntryReader,
+    //minizip doesn't read more than this size
+    long long len = readCurrentFile(this->p->zipfile_handle, fileContent.data(), fileContent.size());
+    bool read_ok = len == static_cast<long long>(fileContent.size());
+
+    //close file, checks the crc-32
+    if(UNZ_OK != unzCloseCurrentFile(this->p->zipfile_handle)){
+        read_ok = false;
+    }
+
+    if(! read_ok){
+        fileContent.clear();
+    }
+
+    return fileContent;
+}
+
+bool Unzip::getFileContent(const std::string& fileName,
+                           unsigned char* buffer,
+                           size_t bufferSize,
+                           size_t& contentSize)
+{
+    contentSize = 0;
+
+    if(! isFile(fileName) || getFileSize(fileName) > bufferSize){
+        return false;
+    }
 
-    unsigned int len = 0;
-    while((len = unzReadCurrentFile(
-            this->p->zipfile_handle,
-            buffer,
-            CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE))
-    ){
-        for(unsigned int i = 0; i < len; ++i){
-            fileContent.push_back(buffer[i]);
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info != NULL && this->p->readAt && EntryReader::canRead(*info)){
+        EntryReader reader(this->p->readAt);
+        if(! reader.open(*info) || ! reader.readAll(buffer)){
+            return false;
         }
+
+        contentSize = static_cast<size_t>(info->uncompressedSize);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(this->p->handleMutex);
+
+    //locate file
+    if(! goToFile(fileName)){
+        return false;
     }
 
-    //close file
+    //open file
+    if(UNZ_OK != unzOpenCurrentFile3(this->p->zipfile_handle,
+                                     NULL, NULL, 0,
+                                     formatPassword(this->p->password)))
+    {
+        return false;
+    }
+
+    //the content must have the size of the central directory, like with EntryReader
+    unsigned long long fileSize = getFileSize(fileName);
+    long long len = readCurrentFile(this->p->zipfile_handle, buffer, fileSize);
+    bool read_ok = len == static_cast<long long>(fileSize);
+
+    //close file, checks the crc-32
     if(UNZ_OK != unzCloseCurrentFile(this->p->zipfile_handle)){
-        return fileContent;
+        read_ok = false;
+    }
+
+    contentSize = read_ok ? static_cast<size_t>(fileSize) : 0;
+
+    return read_ok;
+}
+
+std::vector<unsigned char> Unzip::getFileContent(const std::string& fileName,
+                                                 unsigned long long offset,
+                                                 size_t length)
+{
+    std::vector<unsigned char> fileContent;
+
+    unsigned long long fileSize = getFileSize(fileName);
+    if(offset < fileSize){
+        fileContent.resize(static_cast<size_t>(std::min<unsigned long long>(length, fileSize - offset)));
+    }
+
+    size_t contentSize = 0;
+    if(! readFileContentAt_internal(fileName, offset, fileContent.data(), fileContent.size(), contentSize, false)){
+        fileContent.clear();
     }
 
+    fileContent.resize(contentSize);
+
     return fileContent;
 }
 
-bool Unzip::goToFile(const std::string& fileName)
+bool Unzip::readFileContentAt(const std::string& fileName,
+                              unsigned long long offset,
+                              unsigned char* buffer,
+                              size_t size,
+                              size_t& contentSize)
+{
+    return readFileContentAt_internal(fileName, offset, buffer, size, contentSize, true);
+}
+
+bool Unzip::readFileContentAt_internal(const std::string& fileName,
+                                       unsigned long long offset,
+                                       unsigned char* buffer,
+                                       size_t size,
+                                       size_t& contentSize,
+                                       bool buildCheckpointIndex)
 {
-    if(containsFile(fileName) == false){
+    contentSize = 0;
+
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL || ! isFile(fileName)){
         return false;
     }
 
-    if(unzLocateFile(this->p->zipfile_handle, fileName.c_str(), 0) == UNZ_OK){
+    if(offset >= info->uncompressedSize || size == 0){
         return true;
+    }
+
+    size_t toRead = static_cast<size_t>(std::min<unsigned long long>(size, info->uncompressedSize - offset));
+
+    //encrypted files and other methods can only be read from the beginning, with the handle of the zip
+    if(! this->p->readAt || ! EntryReader::canRead(*info)){
+        std::lock_guard<std::mutex> lock(this->p->handleMutex);
+
+        if(! goToFile(fileName) ||
+           UNZ_OK != unzOpenCurrentFile3(this->p->zipfile_handle,
+                                         NULL, NULL, 0,
+                                         formatPassword(this->p->password)))
+        {
+            return false;
+        }
+
+        std::shared_ptr<InflaterPool::Buffer> discard = InflaterPool::getInstance().acquireBuffer();
+        unsigned long long skipped = 0;
+        bool read_ok = true;
+
+        while(read_ok && skipped < offset){
+            long long len = readCurrentFile(this->p->zipfile_handle, discard->data(),
+                                            std::min<unsigned long long>(offset - skipped, discard->size()));
+            read_ok = len > 0;
+            skipped += read_ok ? static_cast<unsigned long long>(len) : 0;
+        }
+
+        read_ok = read_ok && readCurrentFile(this->p->zipfile_handle, buffer, toRead) == static_cast<long long>(toRead);
+
+        //checks the crc-32, if the whole file is read
+        if(UNZ_OK != unzCloseCurrentFile(this->p->zipfile_handle)){
+            read_ok = false;
+        }
+
+        contentSize = read_ok ? toRead : 0;
+        return read_ok;
+    }
+
+    //a stored file can be read at any position
+    Checkpoint storedPosition;
+    storedPosition.uncompressedOffset = offset;
+    const Checkpoint* checkpoint = &storedPosition;
+
+    std::shared_ptr<const CheckpointIndex> checkpointIndex;
+    if(info->method == Z_DEFLATED){
+        if(buildCheckpointIndex && ! this->buildCheckpointIndex(fileName)){
+            return false;
+        }
+
+        //without an index from the beginning
+        static const Checkpoint beginning;
+        checkpointIndex = findCheckpointIndex(this->p, fileName);
+        checkpoint = checkpointIndex ? &checkpointIndex->findCheckpoint(offset) : &beginning;
+    }
+
+    EntryReader reader(this->p->readAt);
+    if(! reader.open(*info, *checkpoint)){
+        return false;
+    }
+
+    unsigned long long toSkip = offset - checkpoint->uncompressedOffset;
+    if(reader.skip(toSkip) != static_cast<long long>(toSkip) ||
+       reader.read(buffer, toRead) != static_cast<long long>(toRead))
+    {
+        return false;
+    }
+
+    contentSize = toRead;
+
+    return true;
+}
+
+bool Unzip::getStoredFileRange(const std::string& fileName,
+                               std::string& zipFileName,
+                               unsigned long long& offset,
+                               unsigned long long& length)
+{
+    retrieveAllFileInfosIfNeeded();
+
+    //a zip in memory has no file to read from
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL || ! isFile(fileName) || this->p->zipFileName.empty() || ! this->p->readAt ||
+       ! EntryReader::canRead(*info) || info->method == Z_DEFLATED ||
+       info->compressedSize != info->uncompressedSize)
+    {
+        return false;
+    }
+
+    unsigned long long dataPosition = 0;
+    EntryReader reader(this->p->readAt);
+    if(! reader.readDataPosition(*info, dataPosition)){
+        return false;
+    }
+
+    zipFileName = this->p->zipFileName;
+    offset = dataPosition;
+    length = info->uncompressedSize;
+
+    return true;
+}
+
+bool Unzip::getRawFileContent(const std::string& fileName,
+                              std::vector<unsigned char>& rawContent,
+                              int& method,
+                              unsigned long& crc,
+                              unsigned long long& uncompressedSize)
+{
+    rawContent.clear();
+
+    retrieveAllFileInfosIfNeeded();
+
+    //the raw content of an encrypted file is of no use without the password
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL || ! isFile(fileName) || EntryReader::isEncrypted(*info)){
+        return false;
+    }
+
+    bool read_ok = false;
+    rawContent.resize(static_cast<size_t>(info->compressedSize));
+
+    if(this->p->readAt){
+        //the compressed data follows the local header
+        unsigned long long dataPosition = 0;
+        EntryReader reader(this->p->readAt);
+
+        read_ok = reader.readDataPosition(*info, dataPosition) &&
+                  (rawContent.empty() || this->p->readAt(dataPosition, rawContent.data(), rawContent.size()));
     } else {
+        std::lock_guard<std::mutex> lock(this->p->handleMutex);
+
+        //open file raw, minizip doesn't uncompress it
+        if(goToFile(fileName) &&
+           UNZ_OK == unzOpenCurrentFile3(this->p->zipfile_handle, NULL, NULL, 1, NULL))
+        {
+            read_ok = readCurrentFile(this->p->zipfile_handle, rawContent.data(), rawContent.size()) ==
+                      static_cast<long long>(rawContent.size());
+
+            //the crc-32 isn't checked for raw files
+            unzCloseCurrentFile(this->p->zipfile_handle);
+        }
+    }
+
+    if(! read_ok){
+        rawContent.clear();
         return false;
     }
+
+    method = info->method;
+    crc = info->crc;
+    uncompressedSize = info->uncompressedSize;
+
+    return true;
 }
 
-bool Unzip::containsFile(const std::string& fileName)
+bool Unzip::buildCheckpointIndex(const std::string& fileName, unsigned long long span)
 {
-    if(this->p->fileInfos.count(fileName) == 1){
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL || ! isFile(fileName) || ! this->p->readAt || ! EntryReader::canRead(*info)){
+        return false;
+    }
+
+    //a stored file needs no checkpoints
+    if(info->method != Z_DEFLATED || findCheckpointIndex(this->p, fileName)){
+        return true;
+    }
+
+    std::shared_ptr<CheckpointIndex> checkpointIndex(new CheckpointIndex());
+    if(! checkpointIndex->build(this->p->readAt, *info, span)){
+        return false;
+    }
+
+    addCheckpointIndex(this->p, fileName, checkpointIndex);
+
+    return true;
+}
+
+bool Unzip::saveCheckpointIndex(const std::string& fileName, const std::string& checkpointFileName)
+{
+    std::shared_ptr<const CheckpointIndex> checkpointIndex = findCheckpointIndex(this->p, fileName);
+
+    return checkpointIndex && checkpointIndex->save(checkpointFileName);
+}
+
+bool Unzip::loadCheckpointIndex(const std::string& fileName, const std::string& checkpointFileName)
+{
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL || info->method != Z_DEFLATED){
+        return false;
+    }
+
+    std::shared_ptr<CheckpointIndex> checkpointIndex(new CheckpointIndex());
+    if(! checkpointIndex->load(checkpointFileName, *info)){
+        return false;
+    }
+
+    addCheckpointIndex(this->p, fileName, checkpointIndex);
+
+    return true;
+}
+
+unsigned long long Unzip::getFileSize(const std::string& fileName)
+{
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL){
+        return 0;
+    }
+
+    return info->uncompressedSize;
+}
+
+std::shared_ptr<UnzipFileReader> Unzip::openFileReader(const std::string& fileName)
+{
+    std::shared_ptr<UnzipFileReader> reader;
+
+    if(! isFile(fileName) || ! containsFile(fileName)){
+        return reader;
+    }
+
+    //the reader gets its own handle, so it is independent of the current file
+    unzFile zipfile_handle = openHandle();
+    if(zipfile_handle == NULL){
+        return reader;
+    }
+
+    if(! goToFile(zipfile_handle, fileName) ||
+       UNZ_OK != unzOpenCurrentFile3(zipfile_handle,
+                                     NULL, NULL, 0,
+                                     formatPassword(this->p->password)))
+    {
+        unzClose(zipfile_handle);
+        return reader;
+    }
+
+    reader.reset(new UnzipFileReader());
+    reader->p->zipfile_handle = zipfile_handle;
+    reader->p->memoryRegion = this->p->memoryRegion;
+    reader->p->fileName = fileName;
+    reader->p->fileSize = getFileSize(fileName);
+
+    return reader;
+}
+
+long long Unzip::readCurrentFile(void* zipfile_handle, unsigned char* buffer, unsigned long long size)
+{
+    unsigned long long total = 0;
+
+    while(total < size){
+        //unzReadCurrentFile() reads at most INT_MAX bytes per call
+        unsigned int chunk = static_cast<unsigned int>(
+                std::min(size - total, static_cast<unsigned long long>(INT_MAX)));
+
+        int len = unzReadCurrentFile(zipfile_handle, buffer + total, chunk);
+        if(len < 0){
+            return -1;
+        }
+
+        if(len == 0){
+            break;
+        }
+
+        total += static_cast<unsigned long long>(len);
+    }
+
+    return static_cast<long long>(total);
+}
+
+bool Unzip::goToFile(const std::string& fileName)
+{
+    return goToFile(this->p->zipfile_handle, fileName);
+}
+
+bool Unzip::goToFile(void* zipfile_handle, const std::string& fileName)
+{
+    retrieveAllFileInfosIfNeeded();
+
+    const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+    if(info == NULL){
+        return false;
+    }
+
+    //jump directly to the position stored by retrieveAllFileInfos
+    unz64_file_pos pos;
+    pos.pos_in_zip_directory = info->posInZipDirectory;
+    pos.num_of_file = info->numOfFile;
+
+    if(unzGoToFilePos64(zipfile_handle, &pos) == UNZ_OK){
         return true;
     } else {
         return false;
     }
 }
 
+bool Unzip::containsFile(const std::string& fileName)
+{
+    retrieveAllFileInfosIfNeeded();
+
+    return this->p->fileInfos.contains(fileName);
+}
+
 bool Unzip::isFile(const std::string& path)
 {
     return isFolder(path) == false;
@@ -181,14 +718,21 @@ bool Unzip::extractFileTo(
         const std::string& path,
         const bool& overwriteExistingFile)
 {
-    return extractFileTo_Internal(fileName, path, 1, 1, overwriteExistingFile);
+    {
+        std::lock_guard<std::mutex> lock(this->p->signalMutex);
+        this->p->bytesExtracted = 0;
+        this->p->bytesToExtract = getFileSize(fileName);
+    }
+
+    return extractFileTo_Internal(this->p->zipfile_handle, fileName, path, 1, 1, overwriteExistingFile);
 }
 
 bool Unzip::extractFileTo_Internal(
+        void* zipfile_handle,
         const std::string& fileName,
         const std::string& path,
-        int max,
-        int current,
+        unsigned int max,
+        unsigned int current,
         const bool& overwriteExistingFile)
 {
     if(! containsFile(fileName)){
@@ -203,44 +747,77 @@ bool Unzip::extractFileTo_Internal(
 
     try{
         std::string destinationPath = path;
-        beforeFileExtraction(destinationPath);
-
         boost::filesystem::path p(destinationPath);
-        if(createFolderIfNotExists(p.parent_path().string()) == false){
-            extraction_ok = false;
-        }
 
-        //locate filefileContent
-        if(! goToFile(fileName)){
-            return false;
+        {
+            std::lock_guard<std::mutex> lock(this->p->signalMutex);
+
+            beforeFileExtraction(destinationPath);
+
+            p = destinationPath;
+            if(createFolderIfNotExists(p.parent_path().string()) == false){
+                extraction_ok = false;
+            }
         }
 
-        //open file
-        if(UNZ_OK != unzOpenCurrentFile3(this->p->zipfile_handle,
-                                         NULL, NULL, 0,
-                                         formatPassword(this->p->password)))
-        {
-            return false;
+        const FileInfoRecord* info = this->p->fileInfos.find(fileName);
+        bool useEntryReader = info != NULL && this->p->readAt && EntryReader::canRead(*info);
+        EntryReader reader(this->p->readAt);
+
+        if(useEntryReader){
+            if(! reader.open(*info)){
+                return false;
+            }
+        } else {
+            //locate filefileContent
+            if(! goToFile(zipfile_handle, fileName)){
+                return false;
+            }
+
+            //open file
+            if(UNZ_OK != unzOpenCurrentFile3(zipfile_handle,
+                                             NULL, NULL, 0,
+                                             formatPassword(this->p->password)))
+            {
+                return false;
+            }
         }
 
         //destination
         boost::filesystem::ofstream ofs(p, std::ios::out | std::ios::binary);
+        unsigned long long bytesWritten = 0;
 
-        //copy the content
-        unsigned char buffer[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
+        if(useEntryReader){
+            //copy the content with a buffer of the pool, it is reused for the next file
+            std::shared_ptr<InflaterPool::Buffer> buffer = InflaterPool::getInstance().acquireBuffer();
 
-        unsigned int len = 0;
-        while((len = unzReadCurrentFile(
-                this->p->zipfile_handle,
-                buffer,
-                CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE))
-        ){
-            ofs.write((const char *)buffer, len);
-        }
+            long long len = 0;
+            while((len = reader.read(buffer->data(), buffer->size())) > 0){
+                ofs.write((const char *)buffer->data(), len);
+                bytesWritten += len;
+            }
 
-        //close file
-        if(UNZ_OK != unzCloseCurrentFile(this->p->zipfile_handle)){
-            return false;
+            if(len < 0){
+                extraction_ok = false;
+            }
+        } else {
+            //copy the content
+            unsigned char buffer[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
+
+            unsigned int len = 0;
+            while((len = unzReadCurrentFile(
+                    zipfile_handle,
+                    buffer,
+                    CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE))
+            ){
+                ofs.write((const char *)buffer, len);
+                bytesWritten += len;
+            }
+
+            //close file
+            if(UNZ_OK != unzCloseCurrentFile(zipfile_handle)){
+                return false;
+            }
         }
 
         ofs.flush();
@@ -250,7 +827,11 @@ bool Unzip::extractFileTo_Internal(
         }
         ofs.close();
 
+        std::lock_guard<std::mutex> lock(this->p->signalMutex);
         fileExtracted(destinationPath, max, current);
+
+        this->p->bytesExtracted += bytesWritten;
+        extractionProgress(this->p->bytesExtracted, this->p->bytesToExtract);
     } catch(...){
         return false;
     }
@@ -272,18 +853,15 @@ bool Unzip::extractAllFilesTo(const std::string& path, const bool& overwriteExis
         dest_path += "/";
     }
 
-    int current = 1;
-    for(const auto& iter: this->p->fileInfos){
-        const std::string& fileName = iter.first;
-
+    //create the folders first, then extract the files in the order of their
+    //data, so the zip file is read from the beginning to the end
+    std::list<std::string> allFileNames = getFileNamesInZipOrder();
+    std::list<std::string> fileNames;
+    unsigned long long bytesToExtract = 0;
+    for(const auto& fileName : allFileNames){
         if(isFile(fileName)){
-            bool ok = extractFileTo_Internal(fileName,
-                                             dest_path + fileName,
-                                             this->p->fileInfos.size(), current++,
-                                             overwriteExistingFile);
-            if(!ok){
-                extraction_ok = false;
-            }
+            fileNames.push_back(fileName);
+            bytesToExtract += getFileSize(fileName);
         } else {
             if(createFolderIfNotExists(dest_path + fileName) == false){
                 extraction_ok = false;
@@ -291,9 +869,143 @@ bool Unzip::extractAllFilesTo(const std::string& path, const bool& overwriteExis
         }
     }
 
+    {
+        std::lock_guard<std::mutex> lock(this->p->signalMutex);
+        this->p->bytesExtracted = 0;
+        this->p->bytesToExtract = bytesToExtract;
+    }
+
+    //like fileExtracted always did: max counts the folders too, current is
+    //the number of the file in the order of the extraction
+    unsigned int max = static_cast<unsigned int>(allFileNames.size());
+
+    if(this->p->numThreads > 1 && fileNames.size() > 1){
+        if(! extractFilesTo_Parallel(fileNames, dest_path, max, overwriteExistingFile)){
+            extraction_ok = false;
+        }
+
+        return extraction_ok;
+    }
+
+    unsigned int current = 1;
+
+    for(const auto& fileName: fileNames){
+        bool ok = extractFileTo_Internal(this->p->zipfile_handle,
+                                         fileName,
+                                         dest_path + fileName,
+                                         max, current++,
+                                         overwriteExistingFile);
+        if(!ok){
+            extraction_ok = false;
+        }
+    }
+
     return extraction_ok;
 }
 
+bool Unzip::extractFilesTo_Parallel(
+        const std::list<std::string>& fileNames,
+        const std::string& path,
+        unsigned int max,
+        const bool& overwriteExistingFile)
+{
+    //the biggest files first: balances the work between the threads,
+    //the number of each file is taken before, so it is the same as serial
+    struct FileToExtract
+    {
+        unsigned long long size;
+        std::string fileName;
+        unsigned int current;
+    };
+
+    std::vector<FileToExtract> files;
+    unsigned int current = 1;
+    for(const auto& fileName : fileNames){
+        files.push_back(FileToExtract{getFileSize(fileName), fileName, current++});
+    }
+
+    std::stable_sort(files.begin(), files.end(),
+                     [](const FileToExtract& a, const FileToExtract& b){
+        return a.size > b.size;
+    });
+
+    std::atomic<size_t> nextFile(0);
+    std::atomic<size_t> numExtractedOk(0);
+
+    auto extract = [&](){
+        //each thread has its own handle, because the handle has a current file
+        unzFile zipfile_handle = openHandle();
+        if(zipfile_handle == NULL){
+            return;
+        }
+
+        size_t i;
+        while((i = nextFile++) < files.size()){
+            const std::string& fileName = files[i].fileName;
+
+            if(extractFileTo_Internal(zipfile_handle, fileName, path + fileName,
+                                      max, files[i].current, overwriteExistingFile)){
+                ++numExtractedOk;
+            }
+        }
+
+        unzClose(zipfile_handle);
+    };
+
+    unsigned int numThreads = std::min(this->p->numThreads, static_cast<unsigned int>(files.size()));
+    std::vector<std::thread> threads;
+
+    for(unsigned int i = 0; i < numThreads; ++i){
+        threads.push_back(std::thread(extract));
+    }
+
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    return numExtractedOk == files.size();
+}
+
+bool Unzip::setNumberOfThreads(unsigned int numThreads)
+{
+    if(numThreads == 0){
+        return false;
+    }
+
+    this->p->numThreads = numThreads;
+
+    return true;
+}
+
+unsigned int Unzip::getNumberOfThreads()
+{
+    return this->p->numThreads;
+}
+
+void Unzip::setIndexMode(const IndexModes::Modes& indexMode)
+{
+    this->p->indexMode = indexMode;
+}
+
+IndexModes::Modes Unzip::getIndexMode()
+{
+    return this->p->indexMode;
+}
+
+void Unzip::setIndexFileName(const std::string& indexFileName)
+{
+    this->p->indexFileName = indexFileName;
+}
+
+std::string Unzip::getIndexFileName()
+{
+    if(! this->p->indexFileName.empty() || this->p->zipFileName.empty()){
+        return this->p->indexFileName;
+    }
+
+    return this->p->zipFileName + CPPZIP_UNZIP_INDEX_FILE_EXTENSION;
+}
+
 bool Unzip::createFolderIfNotExists(const std::string& path)
 {
     std::string pathToCreate = path;
@@ -314,48 +1026,102 @@ bool Unzip::createFolderIfNotExists(const std::string& path)
 
 void Unzip::retrieveAllFileInfos()
 {
+    //only the name is read besides the fixed size informations
+    char currentFileName[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
+
+    //the current file of the handle is changed in the meantime, if the infos are read lazy
+    if(UNZ_OK != unzGoToFirstFile(this->p->zipfile_handle)){
+        return;
+    }
+
+    if(this->p->numFiles > 0){
+        this->p->fileInfos.reserve(static_cast<size_t>(this->p->numFiles));
+    }
+
     do{
-        unz_file_pos pos;
-        if(UNZ_OK != unzGetFilePos(this->p->zipfile_handle, &pos)){
+        unz64_file_pos pos;
+        if(UNZ_OK != unzGetFilePos64(this->p->zipfile_handle, &pos)){
+            continue;
+        }
+
+        unz_file_info64 info;
+        if(UNZ_OK != unzGetCurrentFileInfo64(this->p->zipfile_handle, &info,
+                                             currentFileName, CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE,
+                                             NULL, 0, NULL, 0)){
             continue;
         }
 
-        unz_file_info info;
-        char currentFileName[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
-        char currentExtraField[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
-        char currentComment[CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE];
-
-        unzGetCurrentFileInfo(this->p->zipfile_handle, &info,
-                currentFileName, CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE,
-                currentExtraField, CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE,
-                currentComment, CPPZIP_UNZIP_CHAR_ARRAY_BUFFER_SIZE);
-
-        std::shared_ptr<InnerZipFileInfo> innerFileInfo(new InnerZipFileInfo());
-        innerFileInfo->fileName = currentFileName;
-        innerFileInfo->extraField = currentExtraField;
-        innerFileInfo->comment = currentComment;
-        innerFileInfo->time_sec = info.tmu_date.tm_sec;
-        innerFileInfo->time_min = info.tmu_date.tm_min;
-        innerFileInfo->time_hour = info.tmu_date.tm_hour;
-        innerFileInfo->time_day_of_month = info.tmu_date.tm_mday;
-        innerFileInfo->time_month = info.tmu_date.tm_mon;
-        innerFileInfo->time_year = info.tmu_date.tm_year;
-        innerFileInfo->dosDate = info.dosDate;
-        innerFileInfo->crc = info.crc;
-        innerFileInfo->compressed_size = info.compressed_size;
-        innerFileInfo->uncompressed_size = info.uncompressed_size;
-        innerFileInfo->internal_fileAttributes = info.internal_fa;
-        innerFileInfo->external_fileAttributes = info.external_fa;
-
-        this->p->fileInfos.insert(std::make_pair(innerFileInfo->fileName, innerFileInfo));
+        ZPOS64_T localHeaderOffset = 0;
+        if(UNZ_OK != unzGetCurrentFileLocalHeaderPos64(this->p->zipfile_handle, &localHeaderOffset)){
+            continue;
+        }
 
+        FileInfoRecord record;
+        record.posInZipDirectory = pos.pos_in_zip_directory;
+        record.numOfFile = pos.num_of_file;
+        record.compressedSize = info.compressed_size;
+        record.uncompressedSize = info.uncompressed_size;
+        record.localHeaderOffset = localHeaderOffset;
+        record.crc = static_cast<unsigned int>(info.crc);
+        record.dosDate = static_cast<unsigned int>(info.dosDate);
+        record.externalAttributes = static_cast<unsigned int>(info.external_fa);
+        record.internalAttributes = static_cast<unsigned short>(info.internal_fa);
+        record.method = static_cast<unsigned short>(info.compression_method);
+        record.flag = static_cast<unsigned short>(info.flag);
+
+        this->p->fileInfos.insert(currentFileName, record);
 
     } while(UNZ_OK == unzGoToNextFile(this->p->zipfile_handle));
 }
 
-std::shared_ptr<InnerZipFileInfo> Unzip::getFileInfoFromLocalFileInfos(    const std::string& fileName)
+void Unzip::retrieveAllFileInfosIfNeeded()
+{
+    //once the infos are read, they are only read, so no lock is needed
+    if(this->p->fileInfosRetrieved){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->p->fileInfosMutex);
+
+    if(this->p->fileInfosRetrieved || ! isOpened()){
+        return;
+    }
+
+    if(this->p->indexMode == IndexModes::IndexFile){
+        retrieveAllFileInfosWithIndexFile();
+    } else {
+        retrieveAllFileInfos();
+    }
+
+    this->p->fileInfosRetrieved = true;
+}
+
+void Unzip::retrieveAllFileInfosWithIndexFile()
+{
+    //a zip in memory has no file name and no index file
+    ZipFileStamp stamp;
+    std::string indexFileName = getIndexFileName();
+
+    if(indexFileName.empty() || ! readZipFileStamp(this->p->zipFileName, stamp)){
+        retrieveAllFileInfos();
+        return;
+    }
+
+    if(this->p->fileInfos.load(indexFileName, stamp)){
+        return;
+    }
+
+    retrieveAllFileInfos();
+
+    //the index file is only a cache, without it the zip can be read as well
+    this->p->fileInfos.save(indexFileName, stamp);
+}
+
+const FileInfoRecord* Unzip::getFileInfoFromLocalFileInfos(const std::string& fileName)
 {
-    return this->p->fileInfos[fileName];
+    retrieveAllFileInfosIfNeeded();
+
+    return this->p->fileInfos.find(fileName);
 }
 
 } //cppzip
@@ -43,15 +43,21 @@
 
 #include <string>
 #include <list>
-#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <boost/signals2.hpp>
 
+/*! \brief Appended to the name of the zip file to get the default name of the index file. */
+#define CPPZIP_UNZIP_INDEX_FILE_EXTENSION ".idx"
+
+/*! \brief Default distance between the checkpoints of a deflated file, see Unzip::buildCheckpointIndex(). */
+#define CPPZIP_UNZIP_CHECKPOINT_SPAN 1048576
+
 namespace cppzip {
 //forward declaration
-struct InnerZipFileInfo;
+struct FileInfoRecord;
 class UnzipPrivate;
+class UnzipFileReader;
 
 /*!
  * \brief Unzip allows reading files inside a zip file
@@ -73,12 +79,34 @@ public:
      * then open() returns false, because another zip
      * file is already opened.
      *
+     * With ReadModes::MemoryMapped the zip file is mapped into memory. The
+     * central directory and the compressed data are then read directly from
+     * the page cache, without read syscalls and stdio buffering.
+     *
      * \param zipFile is the file (incl. path) to open.
      * \param password is the password which protects the files within the zip.
+     * \param readMode is the way the zip file is read.
      *
      * \return true if the zip file is opened, otherwise false.
      */
-    bool open(const std::string& zipFile, const std::string& password = "");
+    bool open(const std::string& zipFile,
+              const std::string& password = "",
+              const ReadModes::Modes& readMode = ReadModes::Stream);
+
+    /*!
+     * \brief Opens a zip that is already in memory (e.g. received over the network).
+     *
+     * The zip is read directly from data, no temporary file is needed.
+     * data isn't copied, it has to stay valid until the zip is closed and
+     * all readers opened with openFileReader() are closed.
+     *
+     * \param data is the content of the zip file.
+     * \param size is the size of data in bytes.
+     * \param password is the password which protects the files within the zip.
+     *
+     * \return true if the zip is opened, otherwise false.
+     */
+    bool open(const unsigned char* data, size_t size, const std::string& password = "");
 
     /*!
      * \brief Closes a zip file.
@@ -154,10 +182,35 @@ public:
      */
     std::list<std::string> getFileNames();
 
+    /*!
+     * \brief Returns the file names (files, folders) in the order of their data in the zip file.
+     *
+     * getFileNames() lists the files in the order of the central directory,
+     * which is usually, but not necessarily, the order of the data. Reading the
+     * files in the order of getFileNamesInZipOrder() reads the zip file from
+     * the beginning to the end, without seeking back.
+     *
+     * If zip file is not opened or zip file is empty, an empty list
+     * will be returned.
+     *
+     * \return list of file names, sorted by the position of their local header
+     */
+    std::list<std::string> getFileNamesInZipOrder();
+
     /*!
      * \brief Get the file content.
      *
      * If file is a folder or doesn't exist an empty list will be returned.
+     * An empty list is also returned, if the content couldn't be read.
+     *
+     * The vector is allocated once with the uncompressed size of the file and
+     * the content is inflated directly into it.
+     *
+     * getFileContent() can be called by several threads at the same time, while
+     * the zip is opened. The file is read with positional reads and its own
+     * inflate state, only the infos of the files are shared. Encrypted files and
+     * files that are neither stored nor deflated are read through the handle of
+     * the zip, one after the other.
      *
      * This is a usage example of getFileNames():
      * \code
@@ -178,10 +231,231 @@ public:
      *
      * \param fileName is the file inside the zip whose content should be loaded.
      *
-     * \return the content of a file as vector of unsigned char
+     * \return the content of a file as vector of unsigned char. An empty
+     *         vector is returned, if the content doesn't match the size or
+     *         the crc-32 in the central directory.
      */
     std::vector<unsigned char> getFileContent(const std::string& fileName);
 
+    /*!
+     * \brief Get the file content into a buffer owned by the caller.
+     *
+     * The content is inflated directly into buffer. Use getFileSize() to know
+     * how big the buffer has to be. Like getFileContent(const std::string&) it
+     * can be called by several threads at the same time.
+     *
+     * This is a usage example:
+     * \code
+     *  std::vector<unsigned char> buffer(zip.getFileSize("filename.txt"));
+     *  size_t contentSize = 0;
+     *  zip.getFileContent("filename.txt", buffer.data(), buffer.size(), contentSize);
+     * \endcode
+     *
+     * \param fileName is the file inside the zip whose content should be loaded.
+     * \param buffer is the memory where the content is written to.
+     * \param bufferSize is the size of buffer in bytes.
+     * \param contentSize is set to the number of bytes written into buffer.
+     *
+     * \return true if the whole content was written into buffer, false if
+     *         the file is a folder or doesn't exist, the buffer is too small
+     *         or the content couldn't be read or doesn't match the size or
+     *         the crc-32 in the central directory.
+     */
+    bool getFileContent(const std::string& fileName,
+                        unsigned char* buffer,
+                        size_t bufferSize,
+                        size_t& contentSize);
+
+    /*!
+     * \brief Get a part of the file content.
+     *
+     * Only the part is allocated. A stored file is read directly at offset. A
+     * deflated file is inflated from its beginning, or from the checkpoint
+     * before offset if its checkpoint index is built or loaded (see
+     * buildCheckpointIndex()), and inflating stops at the end of the part. The
+     * data before offset is thrown away in a small buffer. Unlike
+     * readFileContentAt() no checkpoint index is built, so reading the head of
+     * a big file costs only the head.
+     *
+     * Like getFileContent(const std::string&) it can be called by several
+     * threads at the same time.
+     *
+     * \param fileName is the file inside the zip whose content should be loaded.
+     * \param offset is the position in the uncompressed content.
+     * \param length is the maximum number of bytes to get.
+     *
+     * \return the part of the content, shorter than length at the end of the
+     *         file. An empty vector is returned, if the file is a folder,
+     *         doesn't exist or the content couldn't be read.
+     */
+    std::vector<unsigned char> getFileContent(const std::string& fileName,
+                                              unsigned long long offset,
+                                              size_t length);
+
+    /*!
+     * \brief Reads a part of the file content, beginning at offset of the uncompressed content.
+     *
+     * A stored file is read directly at offset. A deflated file is inflated
+     * from the checkpoint before offset on (see buildCheckpointIndex()), so a
+     * read costs at most the inflating of one checkpoint span. The first read
+     * of a deflated file builds its checkpoint index, if it isn't built or
+     * loaded already. Encrypted files and files that are neither stored nor
+     * deflated are read as a whole.
+     *
+     * Like getFileContent() it can be called by several threads at the same time.
+     *
+     * This is a usage example:
+     * \code
+     *  //read 4 KiB at 3 GiB
+     *  std::vector<unsigned char> buffer(4096);
+     *  size_t contentSize = 0;
+     *  zip.readFileContentAt("big_file.bin", 3ULL << 30, buffer.data(), buffer.size(), contentSize);
+     * \endcode
+     *
+     * \param fileName is the file inside the zip whose content should be read.
+     * \param offset is the position in the uncompressed content.
+     * \param buffer is the memory where the content is written to.
+     * \param size is the number of bytes to read.
+     * \param contentSize is set to the number of bytes written into buffer, it
+     *                    is less than size at the end of the file.
+     *
+     * \return true if the content could be read, false if the file is a folder
+     *         or doesn't exist or the content couldn't be read.
+     */
+    bool readFileContentAt(const std::string& fileName,
+                           unsigned long long offset,
+                           unsigned char* buffer,
+                           size_t size,
+                           size_t& contentSize);
+
+    /*!
+     * \brief Gets where the content of a stored file is in the zip file.
+     *
+     * The content of a file that is stored (not compressed and not encrypted)
+     * is one piece of the zip file. It can be sent directly from the zip file,
+     * for example with sendfile(), without copying it through the memory.
+     *
+     * This is a usage example:
+     * \code
+     *  std::string zipFileName;
+     *  unsigned long long offset = 0;
+     *  unsigned long long length = 0;
+     *
+     *  if(zip.getStoredFileRange("index.html", zipFileName, offset, length)){
+     *      int fd = open(zipFileName.c_str(), O_RDONLY);
+     *      off_t position = offset;
+     *      sendfile(socket, fd, &position, length);
+     *  }
+     * \endcode
+     *
+     * \param fileName is the file inside the zip.
+     * \param zipFileName is set to the name of the zip file (as it was given to open()).
+     * \param offset is set to the position of the first byte of the content in the zip file.
+     * \param length is set to the size of the content.
+     *
+     * \return true if the file is stored and the zip was opened from a file,
+     *         false if the file doesn't exist, is a folder, is compressed or
+     *         encrypted, or the zip was opened from memory.
+     */
+    bool getStoredFileRange(const std::string& fileName,
+                            std::string& zipFileName,
+                            unsigned long long& offset,
+                            unsigned long long& length);
+
+    /*!
+     * \brief Gets the content of a file as it is in the zip, without uncompressing it.
+     *
+     * The raw content of a deflated file is a raw deflate stream (RFC 1951).
+     * It can be sent as it is, for example as HTTP response with
+     * "Content-Encoding: deflate" (after a zlib header) or wrapped into a gzip
+     * member with crc and uncompressedSize, without compressing it again.
+     *
+     * This is a usage example:
+     * \code
+     *  std::vector<unsigned char> rawContent;
+     *  int method = 0;
+     *  unsigned long crc = 0;
+     *  unsigned long long uncompressedSize = 0;
+     *
+     *  if(zip.getRawFileContent("style.css", rawContent, method, crc, uncompressedSize) &&
+     *     method == Z_DEFLATED)
+     *  {
+     *      //send rawContent as compressed response
+     *  }
+     * \endcode
+     *
+     * \param fileName is the file inside the zip.
+     * \param rawContent is set to the compressed content, its size is the compressed size.
+     * \param method is set to the compression method (0 = stored, Z_DEFLATED = deflated).
+     * \param crc is set to the crc-32 of the uncompressed content.
+     * \param uncompressedSize is set to the size of the uncompressed content.
+     *
+     * \return true if the raw content could be read, false if the file is a
+     *         folder, doesn't exist, is encrypted or couldn't be read.
+     */
+    bool getRawFileContent(const std::string& fileName,
+                           std::vector<unsigned char>& rawContent,
+                           int& method,
+                           unsigned long& crc,
+                           unsigned long long& uncompressedSize);
+
+    /*!
+     * \brief Builds the checkpoint index of a deflated file for readFileContentAt().
+     *
+     * The file is inflated once and about every span bytes of the uncompressed
+     * content a checkpoint is saved, where inflating can start again (like
+     * zran.c of zlib). Each checkpoint needs up to 32 KiB of memory. The index
+     * is kept until the zip is closed.
+     *
+     * \param fileName is the file inside the zip.
+     * \param span is the minimum distance between the checkpoints.
+     *
+     * \return true if the index is built or the file is stored (it needs no
+     *         index), otherwise false.
+     */
+    bool buildCheckpointIndex(const std::string& fileName,
+                              unsigned long long span = CPPZIP_UNZIP_CHECKPOINT_SPAN);
+
+    /*!
+     * \brief Saves the checkpoint index of a file, built with buildCheckpointIndex(), into checkpointFileName.
+     *
+     * \return true if the index could be saved, otherwise false.
+     */
+    bool saveCheckpointIndex(const std::string& fileName, const std::string& checkpointFileName);
+
+    /*!
+     * \brief Loads the checkpoint index of a file, saved with saveCheckpointIndex().
+     *
+     * The index is only loaded, if it was saved for the same file (position,
+     * sizes and crc-32 inside the zip).
+     *
+     * \return true if the index could be loaded, otherwise false.
+     */
+    bool loadCheckpointIndex(const std::string& fileName, const std::string& checkpointFileName);
+
+    /*!
+     * \brief Get the uncompressed size of a file.
+     *
+     * \param fileName is the file inside the zip.
+     *
+     * \return the size in bytes, 0 if the file doesn't exist.
+     */
+    unsigned long long getFileSize(const std::string& fileName);
+
+    /*!
+     * \brief Opens a reader that inflates the content of a file piece by piece.
+     *
+     * Use it for big files that shouldn't be held in memory as a whole.
+     * The reader has its own handle on the zip file and stays valid after
+     * the zip file is closed. See UnzipFileReader for an example.
+     *
+     * \param fileName is the file inside the zip whose content should be read.
+     *
+     * \return the opened reader, or an empty pointer if the file is a folder,
+     *         doesn't exist or couldn't be opened.
+     */
+    std::shared_ptr<UnzipFileReader> openFileReader(const std::string& fileName);
+
     /*!
      * \brief Extracts the file in fileName to the path.
      *
@@ -220,6 +494,13 @@ public:
      * \note If the path doesn't exists, extractAllFilesTo() tries to
      * create the paths and all subdirs.
      *
+     * The files are extracted in the order of their data in the zip file (see
+     * getFileNamesInZipOrder()), so the zip file is read sequentially.
+     *
+     * If more than one thread is set (see setNumberOfThreads()), the files are
+     * extracted in parallel. Each thread opens the zip file by itself. The
+     * signals are emitted serialized, but not in the order of the files.
+     *
      * \param path is the folder where the files should be extracted.
      * \param overwriteExistingFile is a flag that controls, if the file specified
      *                              in path should be overwritten if it exists or not.
@@ -233,6 +514,90 @@ public:
     bool extractAllFilesTo(const std::string& path,
                            const bool& overwriteExistingFile = true);
 
+    /*!
+     * \brief Sets the number of threads used by extractAllFilesTo().
+     *
+     *  - 1 = extract with the calling thread only
+     *  - default = 1
+     *
+     * \param numThreads is the number of threads used for extraction.
+     * \return true if numThreads could set, otherwise false (numThreads == 0).
+     *
+     * \see getNumberOfThreads()
+     */
+    bool setNumberOfThreads(unsigned int numThreads);
+
+    /*!
+     * \brief Gets the number of threads used for extraction.
+     *
+     * \return the number of threads.
+     * \see setNumberOfThreads()
+     */
+    unsigned int getNumberOfThreads();
+
+    /*!
+     * \brief Sets when the infos of the files are read.
+     *
+     * With IndexModes::Lazy open() reads only the end of the central directory,
+     * so opening a zip takes the same time regardless of the number of files.
+     * The central directory is read with the first call that needs the infos
+     * of the files (e.g. getFileNames(), containsFile() or getFileContent()).
+     * getNumFiles() doesn't need them.
+     *
+     * With IndexModes::IndexFile open() maps the index file (see
+     * setIndexFileName()) into memory and looks up the files in there, the
+     * central directory isn't read at all. The index file belongs to the zip,
+     * if the size, the modification time and the end of central directory
+     * record of the zip are the same as when the index file was written.
+     * Otherwise the central directory is read and the index file is written
+     * again. Zips opened in memory have no index file, they are read like
+     * with IndexModes::Eager.
+     *
+     * \note The modification time has a resolution of seconds. A zip that is
+     *       changed within the same second, keeps its size and the end of its
+     *       central directory, isn't detected. So use index files for zips
+     *       that don't change anymore.
+     *
+     *  - default = IndexModes::Eager
+     *
+     * The mode is used for the next open().
+     *
+     * \param indexMode is the mode to use.
+     *
+     * \see getIndexMode()
+     */
+    void setIndexMode(const IndexModes::Modes& indexMode);
+
+    /*!
+     * \brief Gets when the infos of the files are read.
+     *
+     * \return the index mode.
+     * \see setIndexMode()
+     */
+    IndexModes::Modes getIndexMode();
+
+    /*!
+     * \brief Sets the name of the index file, used with IndexModes::IndexFile.
+     *
+     *  - default = the name of the zip file + CPPZIP_UNZIP_INDEX_FILE_EXTENSION
+     *
+     * Use it, if the folder of the zip file isn't writable.
+     *
+     * \param indexFileName is the file (incl. path), an empty name sets the default.
+     *
+     * \see getIndexFileName()
+     */
+    void setIndexFileName(const std::string& indexFileName);
+
+    /*!
+     * \brief Gets the name of the index file.
+     *
+     * \return the name of the index file or an empty string, if the default
+     *         name is used and no zip file is opened.
+     * \see setIndexFileName()
+     */
+    std::string getIndexFileName();
+
 public:
     /*!
      * \brief   This signal is emitted, before a file will be extracted.
@@ -258,6 +623,20 @@ public:
                             const unsigned int& maxFiles,
                             const unsigned int& currentFile)> fileExtracted;
 
+    /*!
+     * \brief   This signal is emitted, after a file is extracted and after fileExtracted.
+     *
+     * \details The bytes are counted over all files of an extractFileTo() or
+     *          extractAllFilesTo() call, also if the files are extracted in
+     *          parallel. bytesExtracted reaches bytesToExtract, if all files
+     *          are extracted.
+     *
+     * \param   bytesExtracted is the uncompressed size of the files extracted so far.
+     * \param   bytesToExtract is the uncompressed size of all files to extract.
+     */
+    boost::signals2::signal<void (const unsigned long long& bytesExtracted,
+                            const unsigned long long& bytesToExtract)> extractionProgress;
+
 private:
     /*!
      * Clears the internal members.
@@ -270,19 +649,76 @@ private:
      */
     void getGlobalInfo();
 
+    /*!
+     * Opens the zip handle with openHandle() and reads the file infos.
+     */
+    bool open_internal(const std::string& password);
+
+    /*!
+     * Opens another handle on the opened zip file with the same read mode.
+     * Used for the handles of the threads and of the UnzipFileReader.
+     *
+     * \return the handle or NULL, if the zip file couldn't be opened.
+     */
+    void* openHandle();
+
     /*!
      * Makes the file given in fileName to the current file.
      *
+     * Seeks to the position stored by retrieveAllFileInfos(), so the central
+     * directory isn't scanned.
+     *
      * \param fileName to make to current file
      * \return true if operation was ok, otherwise false.
      */
     bool goToFile(const std::string& fileName);
 
+    /*!
+     * Makes the file given in fileName to the current file of zipfile_handle.
+     */
+    bool goToFile(void* zipfile_handle, const std::string& fileName);
+
+    /*!
+     * Reads the current (opened) file of zipfile_handle into buffer until
+     * buffer is full or the end of the file is reached.
+     *
+     * \return the number of bytes read or -1 on error.
+     */
+    long long readCurrentFile(void* zipfile_handle, unsigned char* buffer, unsigned long long size);
+
+    /*!
+     * Reads size bytes at offset of the uncompressed content of fileName.
+     * Used by readFileContentAt() and getFileContent() with an offset.
+     *
+     * \param buildCheckpointIndex controls, if the checkpoint index of a
+     *                             deflated file is built, if it doesn't exist.
+     *
+     * \return true if the content could be read, otherwise false.
+     */
+    bool readFileContentAt_internal(const std::string& fileName,
+                                    unsigned long long offset,
+                                    unsigned char* buffer,
+                                    size_t size,
+                                    size_t& contentSize,
+                                    bool buildCheckpointIndex);
+
     /*!
      * Reads all elements in the zip file
      */
     void retrieveAllFileInfos();
 
+    /*!
+     * Reads all elements in the zip file, if this isn't done yet.
+     */
+    void retrieveAllFileInfosIfNeeded();
+
+    /*!
+     * Loads all elements from the index file. If the index file doesn't belong
+     * to the zip file, the elements are read from the zip file and the index
+     * file is written.
+     */
+    void retrieveAllFileInfosWithIndexFile();
+
     /*!
      * Creates a folder with all subdirs if not exists
      *
@@ -296,24 +732,42 @@ private:
      * the signal beforeFileExtraction is emitted and the user has the
      * posibility to change the path.
      *
-     * After the extraction is successfully done the fileExtracted signal
-     * is emitted. When extraction fails, the signal will NOT be emitted.
+     * After the extraction is successfully done the fileExtracted and the
+     * extractionProgress signals are emitted. When extraction fails, the
+     * signals will NOT be emitted.
      *
+     * The signals are emitted while p->signalMutex is locked, because
+     * extractFileTo_Internal() is also called by several threads.
+     *
+     * \param zipfile_handle is the opened zip file to read from
      * \param fileName file that should be extracted
      * \param path is the destination
      * \param max describes how much files to extract
-     * \param current the current file that is extracted (begins with 1)
+     * \param current the number of the file (counting begins with 1)
      *
      * \return true if extraction was successful, otherwise false.
      */
     bool extractFileTo_Internal(
+            void* zipfile_handle,
             const std::string& fileName,
             const std::string& path,
-            int max,
-            int current,
+            unsigned int max,
+            unsigned int current,
+            const bool& overwriteExistingFile);
+
+    /*!
+     * Extracts the files with several threads, each thread with its own zip file handle.
+     * The biggest files are extracted first, to balance the work between the threads.
+     *
+     * \return true if all files are extracted, otherwise false.
+     */
+    bool extractFilesTo_Parallel(
+            const std::list<std::string>& fileNames,
+            const std::string& path,
+            unsigned int max,
             const bool& overwriteExistingFile);
 
-    std::shared_ptr<InnerZipFileInfo> getFileInfoFromLocalFileInfos(const std::string& fileName);
+    const FileInfoRecord* getFileInfoFromLocalFileInfos(const std::string& fileName);
 
     bool doesFileExistOnFileSystem(const std::string& fileName);
 
@@ -0,0 +1,129 @@
+/*
+ * UnzipFileReader.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "UnzipFileReader.h"
+#include "MemoryIoApi.h"
+#include "ZipPrivate.h"
+#include "minizip/unzip.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace cppzip {
+
+UnzipFileReader::UnzipFileReader()
+: p(new UnzipFileReaderPrivate())
+{
+
+}
+
+UnzipFileReader::~UnzipFileReader()
+{
+    close();
+    delete p;
+    p = NULL;
+}
+
+bool UnzipFileReader::isOpened()
+{
+    return this->p->zipfile_handle != NULL;
+}
+
+long long UnzipFileReader::read(unsigned char* buffer, size_t size)
+{
+    if(! isOpened()){
+        return -1;
+    }
+
+    if(this->p->endOfFile || size == 0){
+        return 0;
+    }
+
+    //unzReadCurrentFile() reads at most INT_MAX bytes per call
+    unsigned int chunk = static_cast<unsigned int>(
+            std::min(size, static_cast<size_t>(INT_MAX)));
+
+    int len = unzReadCurrentFile(this->p->zipfile_handle, buffer, chunk);
+    if(len < 0){
+        return -1;
+    }
+
+    if(len == 0){
+        this->p->endOfFile = true;
+    }
+
+    this->p->bytesRead += static_cast<unsigned long long>(len);
+
+    return len;
+}
+
+bool UnzipFileReader::isEndOfFile()
+{
+    return this->p->endOfFile;
+}
+
+bool UnzipFileReader::close()
+{
+    if(! isOpened()){
+        return true;
+    }
+
+    //reports UNZ_CRCERROR, if the whole file was read and the crc-32 doesn't match
+    bool close_ok = UNZ_OK == unzCloseCurrentFile(this->p->zipfile_handle);
+
+    if(UNZ_OK != unzClose(this->p->zipfile_handle)){
+        close_ok = false;
+    }
+
+    this->p->zipfile_handle = NULL;
+    this->p->memoryRegion.reset();
+
+    return close_ok;
+}
+
+std::string UnzipFileReader::getFileName()
+{
+    return this->p->fileName;
+}
+
+unsigned long long UnzipFileReader::getFileSize()
+{
+    return this->p->fileSize;
+}
+
+unsigned long long UnzipFileReader::getBytesRead()
+{
+    return this->p->bytesRead;
+}
+
+} //cppzip
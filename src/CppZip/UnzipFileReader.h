@@ -0,0 +1,141 @@
+/*!
+ * \file UnzipFileReader.h
+ *
+ * UnzipFileReader.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_UNZIPFILEREADER_H_
+#define CPPZIP_UNZIPFILEREADER_H_
+
+#include "CppZip_Global.h"
+
+#include <cstddef>
+#include <string>
+
+namespace cppzip {
+//forward declaration
+class Unzip;
+class UnzipFileReaderPrivate;
+
+/*!
+ * \brief UnzipFileReader reads the content of a file inside a zip piece by piece.
+ *
+ * The content is inflated while it is read, so only the data of one read()
+ * call is held in memory. A reader is created with Unzip::openFileReader().
+ * It has its own handle on the zip file, so it doesn't disturb other calls on
+ * the Unzip object and several readers can be used at the same time.
+ *
+ * This is a usage example:
+ * \code
+ *  Unzip zip;
+ *  zip.open("file.zip");
+ *
+ *  std::shared_ptr<UnzipFileReader> reader = zip.openFileReader("big_file.txt");
+ *
+ *  unsigned char buffer[65536];
+ *  long long len = 0;
+ *  while((len = reader->read(buffer, sizeof(buffer))) > 0){
+ *      //process len bytes of buffer
+ *  }
+ *
+ *  bool ok = (len == 0) && reader->close(); //close() checks the crc-32
+ * \endcode
+ */
+class CPPZIP_SHARED_EXPORT UnzipFileReader {
+public:
+    /*!
+     * \brief Closes the reader, if not closed already.
+     */
+    ~UnzipFileReader();
+
+    /*!
+     * \brief Checks if the reader is opened.
+     *
+     * \return true if the reader is opened, otherwise false.
+     */
+    bool isOpened();
+
+    /*!
+     * \brief Reads the next piece of the content.
+     *
+     * \param buffer is the memory where the content is written to.
+     * \param size is the maximum number of bytes to read.
+     *
+     * \return the number of bytes read, 0 at the end of the file and -1 on error.
+     */
+    long long read(unsigned char* buffer, size_t size);
+
+    /*!
+     * \brief Checks if the whole content is read.
+     *
+     * \return true if the end of the file is reached, otherwise false.
+     */
+    bool isEndOfFile();
+
+    /*!
+     * \brief Closes the reader.
+     *
+     * When the whole content is read, the crc-32 of the content is checked.
+     *
+     * \return true if the reader could be closed and the crc-32 is ok, otherwise false.
+     */
+    bool close();
+
+    /*!
+     * \brief Gets the name of the file inside the zip.
+     */
+    std::string getFileName();
+
+    /*!
+     * \brief Gets the uncompressed size of the file.
+     */
+    unsigned long long getFileSize();
+
+    /*!
+     * \brief Gets the number of bytes read so far.
+     */
+    unsigned long long getBytesRead();
+
+private:
+    friend class Unzip;
+
+    UnzipFileReader();
+    UnzipFileReader(const UnzipFileReader&);
+    UnzipFileReader& operator=(const UnzipFileReader&);
+
+private:
+    UnzipFileReaderPrivate* p;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_UNZIPFILEREADER_H_ */
@@ -6,16 +6,23 @@
  */
 
 #include "Zip.h"
+#include "ZipFileWriter.h"
+#include "ZipTransaction.h"
+#include "CentralDirectory.h"
+#include "MemoryIoApi.h"
 #include "ZipCommon.h"
 #include "minizip/zip.h"
 #include "minizip/unzip.h"
 #include "Unzip.h"
 #include "ZipPrivate.h"
+#include "ThreadPool.h"
+#include "ParallelDeflate.h"
 
 #include <algorithm>
 #include <fstream>
 #include <vector>
 #include <list>
+#include <unordered_set>
 #include <time.h>
 
 #include <boost/filesystem.hpp>
@@ -35,6 +42,76 @@ namespace cppzip {
 
 #define CPPZIP_ZIP_CHAR_ARRAY_BUFFER_SIZE 65536
 
+/* Buffer size for copying the raw content of a file from one zip into another. */
+#define CPPZIP_ZIP_RAW_COPY_BUFFER_SIZE (1024 * 1024)
+
+/* Files up to this size are compressed into memory with a pooled deflate state,
+   by addFiles() and addFolder() in the worker threads when more than one thread is set.
+   Larger files are compressed block wise. */
+#define CPPZIP_ZIP_PIPELINE_MAX_FILE_SIZE (4 * 1024 * 1024)
+
+namespace {
+
+/*
+ * Reads the file into memory and compresses it. Is executed by the worker threads.
+ */
+DeflatedData deflateFile(const std::string& fileName, unsigned long long size, int compressionLevel)
+{
+    boost::filesystem::ifstream ifs(fileName, std::ios::in | std::ios::binary);
+
+    if(! ifs.is_open()){
+        return DeflatedData();
+    }
+
+    std::vector<unsigned char> content(static_cast<size_t>(size));
+    ifs.read(reinterpret_cast<char*>(content.data()), content.size());
+    content.resize(static_cast<size_t>(ifs.gcount()));
+
+    //the file has grown in the meantime
+    char buffer[CPPZIP_ZIP_CHAR_ARRAY_BUFFER_SIZE];
+    while(ifs.good()){
+        ifs.read(buffer, CPPZIP_ZIP_CHAR_ARRAY_BUFFER_SIZE);
+        content.insert(content.end(), buffer, buffer + ifs.gcount());
+    }
+
+    if(ifs.bad()){
+        return DeflatedData();
+    }
+
+    return deflateData(compressionLevel, content.data(), content.size());
+}
+
+/*
+ * Removes the zip64 extended information (header id 0x0001) from an extra field.
+ * minizip writes its own one, if the sizes or the offset need it.
+ */
+std::vector<unsigned char> removeZip64ExtendedInformation(const std::vector<unsigned char>& extraField)
+{
+    std::vector<unsigned char> result;
+    size_t pos = 0;
+
+    while(pos + 4 <= extraField.size()){
+        unsigned int headerId = extraField[pos] | (extraField[pos + 1] << 8);
+        size_t blockSize = 4 + (extraField[pos + 2] | (extraField[pos + 3] << 8));
+
+        if(pos + blockSize > extraField.size()){ //malformed: keep the rest as it is
+            break;
+        }
+
+        if(headerId != 0x0001){
+            result.insert(result.end(), extraField.begin() + pos, extraField.begin() + pos + blockSize);
+        }
+
+        pos += blockSize;
+    }
+
+    result.insert(result.end(), extraField.begin() + pos, extraField.end());
+
+    return result;
+}
+
+} //anonymous namespace
+
 Zip::Zip()
     : p(new ZipPrivate())
 {
@@ -58,6 +135,7 @@ bool Zip::open(const std::string& fileName,
 
     this->p->openFlag = flag;
     this->p->password = password;
+    this->p->buffer = NULL;
 
     boost::filesystem::path path(fileName);
     path = path.remove_filename();
@@ -68,7 +146,7 @@ bool Zip::open(const std::string& fileName,
 
     switch (this->p->openFlag) {
         case OpenFlags::OpenExisting:{
-            this->p->fileInfos = retrieveFileInfos(fileName);
+            retrieveFileInfos(fileName, this->p->fileInfos);
             this->p->zipfile_handle = zipOpen(fileName.c_str(), APPEND_STATUS_ADDINZIP);
             break;
         }
@@ -85,27 +163,61 @@ bool Zip::open(const std::string& fileName,
     return isOpened();
 }
 
+bool Zip::open(std::vector<unsigned char>& buffer,
+               const OpenFlags::Flags& flag,
+               const std::string& password)
+{
+    if(isOpened()){ //if already opened, don't open a file
+        return false;
+    }
+
+    this->p->openFlag = flag;
+    this->p->password = password;
+    this->p->buffer = &buffer;
+    this->p->zipFileName.clear();
+
+    zlib_filefunc64_def filefunc;
+    fillMemoryFileFunc(&filefunc, &buffer);
+
+    switch (this->p->openFlag) {
+        case OpenFlags::OpenExisting:{
+            Unzip unzip;
+            if(unzip.open(buffer.data(), buffer.size())){
+                this->p->fileInfos.swap(unzip.p->fileInfos);
+                unzip.close();
+            }
+
+            this->p->zipfile_handle = zipOpen2_64("", APPEND_STATUS_ADDINZIP, NULL, &filefunc);
+            break;
+        }
+        default:{
+            this->p->zipfile_handle = zipOpen2_64("", APPEND_STATUS_CREATE, NULL, &filefunc);
+            break;
+        }
+    }
+
+    return isOpened();
+}
+
 bool Zip::isOpened()
 {
     return this->p->zipfile_handle != NULL;
 }
 
-std::unordered_map<std::string, std::shared_ptr<InnerZipFileInfo> >
-    Zip::retrieveFileInfos(const std::string& fileName)
+void Zip::retrieveFileInfos(const std::string& fileName, FileInfoIndex& fileInfos)
 {
-    std::unordered_map<std::string, std::shared_ptr<InnerZipFileInfo> > fileInfos_;
+    fileInfos.clear();
 
     Unzip unzip;
     bool ok = unzip.open(fileName);
     if(!ok){
-        return fileInfos_;
+        return;
     }
 
-    fileInfos_ = unzip.p->fileInfos;
+    //the index of unzip isn't needed anymore, so it is taken over
+    fileInfos.swap(unzip.p->fileInfos);
 
     unzip.close();
-
-    return fileInfos_;
 }
 
 bool Zip::addFile(const std::string& fileName, const std::vector<unsigned char>& content)
@@ -118,7 +230,7 @@ bool Zip::addFile(const std::string& fileName, const std::vector<unsigned char>&
 bool Zip::addFile_internal(
         std::shared_ptr<InnerZipFileInfo> info, const std::vector<unsigned char>& content)
 {
-    if(containsFile(info->fileName) || info->fileName.length() == 0){
+    if(isFileWriterOpened() || containsFile(info->fileName) || info->fileName.length() == 0){
         return false;
     }
 
@@ -155,7 +267,7 @@ bool Zip::addFile_internal(
         return false;
     }
 
-    this->p->fileInfos[info->fileName] = info;
+    this->p->fileInfos.insert(info->fileName);
 
     //close file
     if(ZIP_OK != zipCloseFileInZip(this->p->zipfile_handle)){
@@ -167,8 +279,7 @@ bool Zip::addFile_internal(
 
 bool Zip::containsFile(const std::string& fileName)
 {
-    int count = this->p->fileInfos.count(fileName);
-    return count == 1;
+    return this->p->fileInfos.contains(fileName);
 }
 
 bool Zip::addFile(const std::string& fileName, bool preservePath)
@@ -192,7 +303,7 @@ bool Zip::addFile(const std::string& fileName, bool preservePath)
 
 bool Zip::addFile_internal(std::shared_ptr<InnerZipFileInfo> info, const std::string& fileName)
 {
-    if(containsFile(info->fileName) || info->fileName.length() == 0){
+    if(isFileWriterOpened() || containsFile(info->fileName) || info->fileName.length() == 0){
         return false;
     }
 
@@ -203,6 +314,16 @@ bool Zip::addFile_internal(std::shared_ptr<InnerZipFileInfo> info, const std::st
         return false;
     }
 
+    //large files are compressed in parallel, if more than one thread is configured
+    if(this->p->numThreads > 1){
+        boost::system::error_code error;
+        unsigned long long fileSize = boost::filesystem::file_size(fileName, error);
+
+        if(! error && fileSize > CPPZIP_PARALLEL_DEFLATE_BLOCK_SIZE){
+            return addLargeFile_internal(info, ifs, fileSize);
+        }
+    }
+
     zip_fileinfo zipFileInfo = convertInnerZipFileInfo_to_zipFileInfo(info);
 
     //open file inside zip
@@ -247,7 +368,7 @@ bool Zip::addFile_internal(std::shared_ptr<InnerZipFileInfo> info, const std::st
 
     ifs.close();
 
-    this->p->fileInfos[info->fileName] = info;
+    this->p->fileInfos.insert(info->fileName);
 
     //close file
     if(ZIP_OK != zipCloseFileInZip(this->p->zipfile_handle)){
@@ -257,6 +378,64 @@ bool Zip::addFile_internal(std::shared_ptr<InnerZipFileInfo> info, const std::st
     return true;
 }
 
+bool Zip::addLargeFile_internal(
+        std::shared_ptr<InnerZipFileInfo> info,
+        std::istream& input,
+        unsigned long long size)
+{
+    //minizip takes the text flag only from its own deflate stream, a raw file stays marked as binary
+    zip_fileinfo zipFileInfo = convertInnerZipFileInfo_to_zipFileInfo(info);
+    int raw = 1;
+
+    //open file inside zip, the content is written raw (already compressed)
+    if(ZIP_OK != zipOpenNewFileInZip4_64 (
+            this->p->zipfile_handle,
+            info->fileName.c_str(),
+            &zipFileInfo,
+            NULL,
+            0,
+            NULL,
+            0,
+            info->comment.c_str(),
+            Z_DEFLATED,
+            this->p->compressionLevel,
+            raw,
+            -MAX_WBITS,
+            DEF_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY,
+            formatPassword(this->p->password),
+            0,
+            VERSIONMADEBY,
+            0,
+            size >= 0xffffffff ? 1 : 0)){
+        return false;
+    }
+
+    zipFile zipfile_handle = this->p->zipfile_handle;
+    ParallelDeflate deflate(*this->p->threadPool, this->p->compressionLevel);
+
+    bool ok = deflate.compress(input, [zipfile_handle](const unsigned char* data, unsigned int length){
+        return ZIP_OK == zipWriteInFileInZip(zipfile_handle, data, length);
+    });
+
+    if(! ok){
+        //try to close...
+        zipCloseFileInZipRaw64(this->p->zipfile_handle, deflate.getUncompressedSize(), deflate.getCrc());
+        return false;
+    }
+
+    this->p->fileInfos.insert(info->fileName);
+
+    //close file
+    if(ZIP_OK != zipCloseFileInZipRaw64(this->p->zipfile_handle,
+                                        deflate.getUncompressedSize(),
+                                        deflate.getCrc())){
+        return false;
+    }
+
+    return true;
+}
+
 std::shared_ptr<InnerZipFileInfo> Zip::getFileInfoForANewFile(const std::string& fileName)
 {
     std::shared_ptr<InnerZipFileInfo> info(new InnerZipFileInfo());
@@ -313,11 +492,6 @@ std::shared_ptr<InnerZipFileInfo> Zip::getFileInfoForAExistingFile(const std::st
     return info;
 }
 
-std::shared_ptr<InnerZipFileInfo> Zip::getFileInfoFromLocalFileInfos(const std::string& fileName)
-{
-    return this->p->fileInfos[fileName];
-}
-
 unsigned long Zip::getExternalFileAttributesFromExistingFile(
         const std::string& fileName)
 {
@@ -340,11 +514,34 @@ unsigned long Zip::getExternalFileAttributesFromExistingFile(
 bool Zip::addFiles(const std::list<std::string>& fileNames, bool preservePath)
 {
     bool ok = true;
+    std::vector<PendingEntry> entries;
 
     for(const auto& fileName : fileNames){
-        if(! addFile(fileName, preservePath)){
+        std::string destFileName = fileName;
+        if(! preservePath){
+            destFileName = boost::filesystem::path(fileName).filename().string();
+        }
+
+        if(destFileName.length() == 0){
             ok = false;
+            continue;
         }
+
+        try{
+            std::shared_ptr<InnerZipFileInfo> info = getFileInfoForAExistingFile(fileName);
+            info->fileName = destFileName;
+
+            boost::system::error_code error;
+            unsigned long long size = boost::filesystem::file_size(fileName, error);
+
+            entries.push_back(PendingEntry(info, fileName, error ? 0 : size, false));
+        } catch(std::exception& e){
+            ok = false;
+        }
+    }
+
+    if(! addEntries_internal(entries, false)){
+        ok = false;
     }
 
     return ok;
@@ -377,6 +574,22 @@ bool Zip::addFolder(const std::string& folderName, bool preservePath, bool recur
 bool Zip::addFolder(
             const std::string& realFolderName, const std::string& relativeFolderName,
             bool preservePath, bool recursive)
+{
+    std::vector<PendingEntry> entries;
+    collectFolderEntries(realFolderName, relativeFolderName, preservePath, recursive, entries);
+
+    //the first entry is the folder itself
+    if(containsFile(entries.front().info->fileName)){
+        return false;
+    }
+
+    return addEntries_internal(entries, true);
+}
+
+void Zip::collectFolderEntries(
+                const std::string& realFolderName, const std::string& relativeFolderName,
+                bool preservePath, bool recursive,
+                std::vector<PendingEntry>& entries)
 {
     std::string folderNameToAdd;
 
@@ -390,23 +603,10 @@ bool Zip::addFolder(
         folderNameToAdd += "/";
     }
 
-    if(containsFile(folderNameToAdd)){
-        return false;
-    }
-
     std::shared_ptr<InnerZipFileInfo> info = getFileInfoForAExistingFile(realFolderName);
     info->fileName = folderNameToAdd;
-    if(! addFolder_internal(info)){
-        return false;
-    }
-
-    return addFolderChilds(realFolderName, folderNameToAdd, preservePath, recursive);
-}
+    entries.push_back(PendingEntry(info, realFolderName, 0, true));
 
-bool Zip::addFolderChilds(
-                const std::string& realFolderName, const std::string& folderNameToAdd,
-                bool preservePath, bool recursive)
-{
     boost::filesystem::directory_iterator iter(realFolderName);
     boost::filesystem::directory_iterator end;
 
@@ -423,16 +623,179 @@ bool Zip::addFolderChilds(
         boost::algorithm::replace_all(destName, "\\", "/");
 
         if(boost::filesystem::is_regular_file(dirEntry)){
-            if(! addFile(dirEntry.string(), destName)){
-                return false;
-            }
+            std::shared_ptr<InnerZipFileInfo> fileInfo = getFileInfoForAExistingFile(dirEntry.string());
+            fileInfo->fileName = destName;
+
+            boost::system::error_code error;
+            unsigned long long size = boost::filesystem::file_size(dirEntry, error);
+
+            entries.push_back(PendingEntry(fileInfo, dirEntry.string(), error ? 0 : size, false));
 
         } else if(boost::filesystem::is_directory(dirEntry) && recursive){
+            collectFolderEntries(dirEntry.string(), destName, preservePath, recursive, entries);
+        }
+    }
+}
 
-            if(! addFolder(dirEntry.string(), destName, preservePath, recursive)){
-                return false;
+bool Zip::addEntries_internal(const std::vector<PendingEntry>& entries, bool stopAtFirstFailure)
+{
+    if(isFileWriterOpened()){
+        return false;
+    }
+
+    bool ok = true;
+
+    if(this->p->numThreads <= 1){
+        for(const auto& entry : entries){
+            if(! addEntry_internal(entry)){
+                ok = false;
+                if(stopAtFirstFailure){
+                    break;
+                }
             }
         }
+
+        return ok;
+    }
+
+    //The files are compressed by the thread pool into memory, while this thread
+    //writes the compressed data in the order of entries into the zip. The number
+    //of files (and bytes) in flight is limited to bound the memory usage.
+    const size_t maxFilesInFlight = 8 * this->p->numThreads;
+    const unsigned long long maxBytesInFlight =
+            2ULL * this->p->numThreads * CPPZIP_ZIP_PIPELINE_MAX_FILE_SIZE;
+
+    std::vector<std::future<DeflatedData> > deflatedFiles(entries.size());
+    size_t filesInFlight = 0;
+    unsigned long long bytesInFlight = 0;
+    size_t nextEntry = 0;
+    int compressionLevel = this->p->compressionLevel;
+
+    for(size_t i = 0; i < entries.size(); ++i){
+        //keep the pool busy
+        while(nextEntry < entries.size() &&
+              filesInFlight < maxFilesInFlight &&
+              bytesInFlight < maxBytesInFlight)
+        {
+            const PendingEntry& entry = entries[nextEntry];
+
+            if(! entry.isFolder && entry.size <= CPPZIP_ZIP_PIPELINE_MAX_FILE_SIZE){
+                std::string fileName = entry.fileName;
+                unsigned long long size = entry.size;
+
+                deflatedFiles[nextEntry] = this->p->threadPool->submit([fileName, size, compressionLevel](){
+                    return deflateFile(fileName, size, compressionLevel);
+                });
+
+                ++filesInFlight;
+                bytesInFlight += entry.size;
+            }
+
+            ++nextEntry;
+        }
+
+        const PendingEntry& entry = entries[i];
+        bool entryOk;
+
+        if(deflatedFiles[i].valid()){
+            DeflatedData deflatedData = deflatedFiles[i].get();
+            --filesInFlight;
+            bytesInFlight -= entry.size;
+
+            entryOk = deflatedData.ok && addDeflatedFile_internal(entry.info, deflatedData);
+        } else {
+            //folders and large files (which are compressed in parallel by themselves)
+            entryOk = addEntry_internal(entry);
+        }
+
+        if(! entryOk){
+            ok = false;
+            if(stopAtFirstFailure){
+                break;
+            }
+        }
+    }
+
+    //the not yet written files are still compressed by the pool, wait for them
+    for(auto& deflatedFile : deflatedFiles){
+        if(deflatedFile.valid()){
+            deflatedFile.wait();
+        }
+    }
+
+    return ok;
+}
+
+bool Zip::addEntry_internal(const PendingEntry& entry)
+{
+    if(entry.isFolder){
+        if(containsFile(entry.info->fileName)){
+            return false;
+        }
+
+        return addFolder_internal(entry.info);
+    }
+
+    return addFile_internal(entry.info, entry.fileName);
+}
+
+bool Zip::addDeflatedFile_internal(
+        std::shared_ptr<InnerZipFileInfo> info,
+        const DeflatedData& deflatedData)
+{
+    if(containsFile(info->fileName) || info->fileName.length() == 0){
+        return false;
+    }
+
+    zip_fileinfo zipFileInfo = convertInnerZipFileInfo_to_zipFileInfo(info);
+
+    //the same as minizip does, when it compresses the data by itself
+    if(deflatedData.dataType == Z_ASCII){
+        zipFileInfo.internal_fa = Z_ASCII;
+    }
+
+    int raw = 1;
+
+    //open file inside zip, the content is written raw (already compressed)
+    if(ZIP_OK != zipOpenNewFileInZip4_64 (
+            this->p->zipfile_handle,
+            info->fileName.c_str(),
+            &zipFileInfo,
+            NULL,
+            0,
+            NULL,
+            0,
+            info->comment.c_str(),
+            Z_DEFLATED,
+            this->p->compressionLevel,
+            raw,
+            -MAX_WBITS,
+            DEF_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY,
+            formatPassword(this->p->password),
+            0,
+            VERSIONMADEBY,
+            0,
+            0)){
+        return false;
+    }
+
+    //write content
+    if(ZIP_OK != zipWriteInFileInZip(this->p->zipfile_handle,
+                                     deflatedData.data.data(),
+                                     static_cast<unsigned int>(deflatedData.data.size()))){
+        //try to close...
+        zipCloseFileInZipRaw64(this->p->zipfile_handle, deflatedData.uncompressedSize, deflatedData.crc);
+        return false;
+    }
+
+    this->p->fileInfos.insert(info->fileName);
+
+    //close file
+    if(ZIP_OK != zipCloseFileInZipRaw64(this->p->zipfile_handle,
+                                        deflatedData.uncompressedSize,
+                                        deflatedData.crc)){
+        return false;
     }
 
     return true;
@@ -460,6 +823,55 @@ bool Zip::addFolder_internal(std::shared_ptr<InnerZipFileInfo> info)
     return addFile_internal(info, emptyData);
 }
 
+std::shared_ptr<ZipFileWriter> Zip::openFileWriter(const std::string& fileName, bool largeFile)
+{
+    std::shared_ptr<ZipFileWriter> writer;
+
+    if(! isOpened() || isFileWriterOpened() ||
+       containsFile(fileName) || fileName.length() == 0){
+        return writer;
+    }
+
+    std::shared_ptr<InnerZipFileInfo> info = getFileInfoForANewFile(fileName);
+    zip_fileinfo zipFileInfo = convertInnerZipFileInfo_to_zipFileInfo(info);
+
+    //open file inside zip, it stays opened until the writer is closed
+    if(ZIP_OK != zipOpenNewFileInZip4_64 (
+            this->p->zipfile_handle,
+            info->fileName.c_str(),
+            &zipFileInfo,
+            NULL,
+            0,
+            NULL,
+            0,
+            info->comment.c_str(),
+            Z_DEFLATED,
+            this->p->compressionLevel,
+            0,
+            -MAX_WBITS,
+            DEF_MEM_LEVEL,
+            Z_DEFAULT_STRATEGY,
+            formatPassword(this->p->password),
+            0,
+            VERSIONMADEBY,
+            0,
+            largeFile ? 1 : 0)){
+        return writer;
+    }
+
+    writer.reset(new ZipFileWriter());
+    writer->p->zip = this->p;
+    writer->p->info = info;
+    this->p->fileWriter = writer.get();
+
+    return writer;
+}
+
+bool Zip::isFileWriterOpened()
+{
+    return this->p->fileWriter != NULL;
+}
+
 bool Zip::deleteFile(const std::string& fileName)
 {
     std::list<std::string> fileNames;
@@ -470,31 +882,43 @@ bool Zip::deleteFile(const std::string& fileName)
 
 bool Zip::deleteFiles(const std::list<std::string>& fileNames)
 {
-    if(! isOpened()){
+    if(! isOpened() || isFileWriterOpened()){
         return false;
     }
 
-    //remember the openFlag
-    enum OpenFlags::Flags oldOpenFlag = this->p->openFlag;
-
     //check if a file or a folder with a name in fileNames exists
     if(! containsAnyFile(fileNames)){
         return true;
     }
 
+    return rewrite_internal(fileNames, std::list<std::string>());
+}
+
+bool Zip::rewrite_internal(const std::list<std::string>& fileNames,
+                           const std::list<std::string>& folderNames,
+                           const ZipTransactionPrivate* transaction)
+{
+    //remember the openFlag
+    enum OpenFlags::Flags oldOpenFlag = this->p->openFlag;
+
     //close the current zip
     if(! close()){
         return false;
     }
 
     //move the current zip to an tempzip
-    std::string tempZipFile = moveTheCurrentZipToAnTempZip();
-    if(tempZipFile.empty()){
+    std::string tempZipFile;
+    if(! moveTheCurrentZipToAnTempZip(tempZipFile)){
         return false;
     }
 
-    //Copy all files and folders into a new zip file, except the fileNames
-    bool ok = copyAllFilesAndFoldersIntoANewZipFileExceptTheFileNames(tempZipFile, fileNames, false);
+    //Copy all files and folders into a new zip file, except the fileNames and folderNames
+    bool ok = copyAllFilesAndFoldersIntoANewZipFileExceptTheFileNames(tempZipFile, fileNames, folderNames);
+
+    if(ok && transaction != NULL){
+        ok = addTransactionFiles_internal(*transaction);
+    }
+
     cleanUpAfterCopying(ok, tempZipFile);
 
     //restore the old open status if necessary
@@ -503,6 +927,137 @@ bool Zip::deleteFiles(const std::list<std::string>& fileNames)
     return ok;
 }
 
+bool Zip::fastDeleteFile(const std::string& fileName)
+{
+    std::list<std::string> fileNames;
+    fileNames.push_back(fileName);
+
+    return fastDeleteFiles(fileNames);
+}
+
+bool Zip::fastDeleteFiles(const std::list<std::string>& fileNames)
+{
+    if(! isOpened() || isFileWriterOpened()){
+        return false;
+    }
+
+    //check if a file or a folder with a name in fileNames exists
+    if(! containsAnyFile(fileNames)){
+        return true;
+    }
+
+    //the file infos stay valid, except the ones of the deleted files
+    FileInfoIndex fileInfos;
+    fileInfos.swap(this->p->fileInfos);
+
+    //close the current zip, to have the central directory written
+    if(! close()){
+        fileInfos.swap(this->p->fileInfos);
+        return false;
+    }
+
+    if(! rewriteCentralDirectoryWithout(fileNames)){
+        reopen(OpenFlags::OpenExisting);
+        return false;
+    }
+
+    for(const auto& fileName : fileNames){
+        fileInfos.erase(fileName);
+    }
+
+    //the zip exists now, so it is opened as existing zip
+    return reopenToAppend(fileInfos);
+}
+
+bool Zip::rewriteCentralDirectoryWithout(const std::list<std::string>& fileNames)
+{
+    std::unordered_set<std::string> fileNamesToDelete(fileNames.begin(), fileNames.end());
+    CentralDirectory centralDirectory;
+
+    auto buildWithoutTheFileNames = [&](){
+        std::vector<const CentralDirectoryEntry*> entries;
+        for(const auto& entry : centralDirectory.entries){
+            if(fileNamesToDelete.count(entry.fileName) == 0){
+                entries.push_back(&entry);
+            }
+        }
+
+        return buildCentralDirectory(entries, centralDirectory.offset, centralDirectory.comment);
+    };
+
+    //zip in memory
+    if(this->p->buffer != NULL){
+        std::vector<unsigned char>& buffer = *this->p->buffer;
+
+        ReadAt readAt = [&buffer](unsigned long long offset, unsigned char* data, size_t length){
+            if(offset + length > buffer.size()){
+                return false;
+            }
+            std::copy(buffer.begin() + offset, buffer.begin() + offset + length, data);
+            return true;
+        };
+
+        if(! readCentralDirectory(readAt, buffer.size(), centralDirectory)){
+            return false;
+        }
+
+        std::vector<unsigned char> newCentralDirectory = buildWithoutTheFileNames();
+        buffer.resize(static_cast<size_t>(centralDirectory.position));
+        buffer.insert(buffer.end(), newCentralDirectory.begin(), newCentralDirectory.end());
+
+        return true;
+    }
+
+    //zip file: write the new central directory over the old one and cut the rest
+    try {
+        boost::filesystem::fstream fs(this->p->zipFileName,
+                                      std::ios::in | std::ios::out | std::ios::binary);
+        if(! fs.is_open()){
+            return false;
+        }
+
+        unsigned long long fileSize = boost::filesystem::file_size(this->p->zipFileName);
+
+        ReadAt readAt = [&fs](unsigned long long offset, unsigned char* data, size_t length){
+            fs.seekg(static_cast<std::streamoff>(offset));
+            fs.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(length));
+            return fs.good() && static_cast<size_t>(fs.gcount()) == length;
+        };
+
+        if(! readCentralDirectory(readAt, fileSize, centralDirectory)){
+            return false;
+        }
+
+        std::vector<unsigned char> newCentralDirectory = buildWithoutTheFileNames();
+
+        fs.seekp(static_cast<std::streamoff>(centralDirectory.position));
+        fs.write(reinterpret_cast<const char*>(newCentralDirectory.data()),
+                 static_cast<std::streamsize>(newCentralDirectory.size()));
+        fs.close();
+
+        if(fs.fail()){
+            return false;
+        }
+
+        boost::filesystem::resize_file(this->p->zipFileName,
+                                       centralDirectory.position + newCentralDirectory.size());
+    } catch (boost::filesystem::filesystem_error& e) {
+        return false;
+    }
+
+    return true;
+}
+
+bool Zip::compact()
+{
+    if(! isOpened() || isFileWriterOpened()){
+        return false;
+    }
+
+    //copying all entries into a new zip leaves out the holes
+    return rewrite_internal(std::list<std::string>(), std::list<std::string>());
+}
+
 bool Zip::containsAnyFile(const std::list<std::string>& fileNames)
 {
     return std::any_of(fileNames.cbegin(), fileNames.cend(), [&](const std::string& fileName){
@@ -510,8 +1065,15 @@ bool Zip::containsAnyFile(const std::list<std::string>& fileNames)
     });
 }
 
-std::string Zip::moveTheCurrentZipToAnTempZip()
+bool Zip::moveTheCurrentZipToAnTempZip(std::string& tempZipFile)
 {
+    if(this->p->buffer != NULL){
+        this->p->tempBuffer.swap(*this->p->buffer);
+        this->p->buffer->clear();
+        tempZipFile.clear();
+        return true;
+    }
+
     boost::filesystem::path p(this->p->zipFileName);
     std::string folderName = p.parent_path().string();
     std::string fileName = p.filename().string();
@@ -521,124 +1083,220 @@ std::string Zip::moveTheCurrentZipToAnTempZip()
     try {
         boost::filesystem::rename(this->p->zipFileName, tempZipFileName);
     } catch (boost::filesystem::filesystem_error& e) {
-        std::string emptyString;
-        return emptyString;
+        return false;
+    }
+
+    tempZipFile = tempZipFileName;
+
+    return true;
+}
+
+bool Zip::reopen(const OpenFlags::Flags& flag)
+{
+    if(this->p->buffer != NULL){
+        return open(*this->p->buffer, flag, this->p->password);
     }
 
-    return tempZipFileName;
+    return open(this->p->zipFileName, flag, this->p->password);
+}
+
+bool Zip::reopenToAppend(FileInfoIndex& fileInfos)
+{
+    if(this->p->buffer != NULL){
+        zlib_filefunc64_def filefunc;
+        fillMemoryFileFunc(&filefunc, this->p->buffer);
+
+        this->p->zipfile_handle = zipOpen2_64("", APPEND_STATUS_ADDINZIP, NULL, &filefunc);
+    } else {
+        this->p->zipfile_handle = zipOpen(this->p->zipFileName.c_str(), APPEND_STATUS_ADDINZIP);
+    }
+
+    if(! isOpened()){
+        return false;
+    }
+
+    this->p->openFlag = OpenFlags::OpenExisting;
+    this->p->fileInfos.swap(fileInfos);
+
+    return true;
 }
 
 bool Zip::copyAllFilesAndFoldersIntoANewZipFileExceptTheFileNames(
         const std::string& tempZipFile,
         const std::list<std::string>& fileNames,
-        bool areFileNamesFolders)
+        const std::list<std::string>& folderNames)
 {
     Unzip unzip;
-    if(! unzip.open(tempZipFile)){
+    bool unzipOpened = this->p->buffer != NULL
+            ? unzip.open(this->p->tempBuffer.data(), this->p->tempBuffer.size())
+            : unzip.open(tempZipFile);
+
+    if(! unzipOpened || ! reopen(OpenFlags::CreateAndOverwrite)){
         return false;
     }
 
-    open(this->p->zipFileName, OpenFlags::CreateAndOverwrite);
+    //one buffer for all files
+    std::vector<unsigned char> buffer(CPPZIP_ZIP_RAW_COPY_BUFFER_SIZE);
 
-    std::list<std::string> zipFileNames = unzip.getFileNames();
-    for(const auto& zipFileName: zipFileNames){
-        if(areFileNamesFolders){
-            //copy all files except the folder and the files in the folder
-            bool equals = false;
-            for(const auto& fileName: fileNames){
-                if(boost::algorithm::starts_with(zipFileName, fileName)){
-                    equals = true;
-                    break;
-                }
-            }
-            if(equals){
-                continue;
-            }
-        } else{
-            bool equals = false;
-            for(const auto& fileName: fileNames){
-                if(zipFileName == fileName){
-                    equals = true;
-                    break;
-                }
-            }
-            if(equals){
-                continue;
-            }
+    std::unordered_set<std::string> fileNamesToSkip(fileNames.begin(), fileNames.end());
+
+    //the index keeps the order of the files inside the zip
+    std::vector<std::string> zipFileNames;
+    zipFileNames.reserve(unzip.p->fileInfos.size());
+    unzip.p->fileInfos.forEach([&](const std::string& fileName, const FileInfoRecord&){
+        zipFileNames.push_back(fileName);
+    });
+
+    for(const auto& zipFileName : zipFileNames){
+
+        if(fileNamesToSkip.count(zipFileName) == 1){
+            continue;
         }
 
-        if(unzip.isFile(zipFileName)){
-            if(! copyFile(unzip, zipFileName)){
-                return false;
-            }
-        } else {
-            if(! addEmptyFolder(zipFileName)){
-                return false;
-            }
+        //copy all files except the folders and the files in the folders
+        bool isInAFolder = std::any_of(folderNames.cbegin(), folderNames.cend(),
+                                       [&](const std::string& folderName){
+            return boost::algorithm::starts_with(zipFileName, folderName);
+        });
+        if(isInAFolder){
+            continue;
+        }
+
+        //folders are copied like files, to keep their time and attributes
+        if(! copyFile(unzip, zipFileName, buffer)){
+            return false;
         }
     }
 
     return unzip.close();
 }
 
-bool Zip::copyFile(Unzip& unzip, const std::string& fileName)
+bool Zip::copyFile(Unzip& unzip, const std::string& fileName, std::vector<unsigned char>& buffer)
 {
-    bool ok;
+    void* handle = unzip.p->zipfile_handle;
 
     //locate file
-    ok = unzip.goToFile(fileName);
+    if(! unzip.goToFile(fileName)){
+        return false;
+    }
 
-    std::shared_ptr<InnerZipFileInfo> info = unzip.getFileInfoFromLocalFileInfos(fileName);
-    zip_fileinfo zipFileInfo = convertInnerZipFileInfo_to_zipFileInfo(info);
+    //the infos of the central directory, incl. the extra field and the comment
+    unz_file_info64 fileInfo;
+    if(UNZ_OK != unzGetCurrentFileInfo64(handle, &fileInfo, NULL, 0, NULL, 0, NULL, 0)){
+        return false;
+    }
+
+    std::vector<unsigned char> globalExtraField(fileInfo.size_file_extra);
+    std::vector<char> comment(fileInfo.size_file_comment + 1, '\0');
+    if(UNZ_OK != unzGetCurrentFileInfo64(handle, &fileInfo, NULL, 0,
+                                         globalExtraField.data(), fileInfo.size_file_extra,
+                                         comment.data(), fileInfo.size_file_comment)){
+        return false;
+    }
 
     int raw = 1;
     int method;
     int level;
 
-    //open the files
-    ok = UNZ_OK == unzOpenCurrentFile3(unzip.p->zipfile_handle, &method, &level, raw, NULL);
-    ok = ZIP_OK == zipOpenNewFileInZip4_64 (
+    //open the file raw, an encryption header is part of the raw data
+    if(UNZ_OK != unzOpenCurrentFile3(handle, &method, &level, raw, NULL)){
+        return false;
+    }
+
+    int localExtraFieldSize = unzGetLocalExtrafield(handle, NULL, 0);
+    std::vector<unsigned char> localExtraField(localExtraFieldSize > 0 ? localExtraFieldSize : 0);
+    if(! localExtraField.empty() &&
+       unzGetLocalExtrafield(handle, localExtraField.data(), localExtraField.size()) != localExtraFieldSize){
+        unzCloseCurrentFile(handle);
+        return false;
+    }
+
+    localExtraField = removeZip64ExtendedInformation(localExtraField);
+    globalExtraField = removeZip64ExtendedInformation(globalExtraField);
+
+    zip_fileinfo zipFileInfo;
+    zipFileInfo.tmz_date.tm_year = fileInfo.tmu_date.tm_year;
+    zipFileInfo.tmz_date.tm_mon  = fileInfo.tmu_date.tm_mon;
+    zipFileInfo.tmz_date.tm_mday = fileInfo.tmu_date.tm_mday;
+    zipFileInfo.tmz_date.tm_hour = fileInfo.tmu_date.tm_hour;
+    zipFileInfo.tmz_date.tm_min  = fileInfo.tmu_date.tm_min;
+    zipFileInfo.tmz_date.tm_sec  = fileInfo.tmu_date.tm_sec;
+    zipFileInfo.dosDate = fileInfo.dosDate;
+    zipFileInfo.internal_fa = fileInfo.internal_fa;
+    zipFileInfo.external_fa = fileInfo.external_fa;
+
+    int zip64 = fileInfo.compressed_size >= 0xffffffff || fileInfo.uncompressed_size >= 0xffffffff;
+
+    if(ZIP_OK != zipOpenNewFileInZip4_64 (
             this->p->zipfile_handle,
-            info->fileName.c_str(),
+            fileName.c_str(),
             &zipFileInfo,
-            NULL,
-            0,
-            NULL,
-            0,
-            info->comment.c_str(),
-            Z_DEFLATED,
-            this->p->compressionLevel,
+            localExtraField.data(),
+            static_cast<uInt>(localExtraField.size()),
+            globalExtraField.data(),
+            static_cast<uInt>(globalExtraField.size()),
+            comment.data(),
+            method,
+            level,
             raw,
             -MAX_WBITS,
             DEF_MEM_LEVEL,
             Z_DEFAULT_STRATEGY,
-            formatPassword(this->p->password),
-            0,
-            VERSIONMADEBY,
+            NULL,
             0,
-            0);
+            fileInfo.version,
+            fileInfo.flag,
+            zip64)){
+        unzCloseCurrentFile(handle);
+        return false;
+    }
 
-    //read and write the content
-    unsigned char buffer[CPPZIP_ZIP_CHAR_ARRAY_BUFFER_SIZE];
+    //read and write the compressed content
+    bool ok = true;
+    int len = 0;
+    while((len = unzReadCurrentFile(handle, buffer.data(), static_cast<unsigned int>(buffer.size()))) > 0){
+        if(ZIP_OK != zipWriteInFileInZip(this->p->zipfile_handle, buffer.data(), len)){
+            ok = false;
+            break;
+        }
+    }
 
-    unsigned int len = 0;
-    while((len = unzReadCurrentFile(
-            unzip.p->zipfile_handle,
-            buffer,
-            CPPZIP_ZIP_CHAR_ARRAY_BUFFER_SIZE))
-    ){
-        ok = ZIP_OK == zipWriteInFileInZip(this->p->zipfile_handle, buffer, len);
+    if(len < 0){
+        ok = false;
     }
 
     //close the files
-    ok = UNZ_OK == unzCloseCurrentFile(unzip.p->zipfile_handle);
-    ok = ZIP_OK == zipCloseFileInZipRaw(this->p->zipfile_handle, info->uncompressed_size, info->crc);
+    if(UNZ_OK != unzCloseCurrentFile(handle)){
+        ok = false;
+    }
+
+    if(ZIP_OK != zipCloseFileInZipRaw64(this->p->zipfile_handle,
+                                        fileInfo.uncompressed_size,
+                                        fileInfo.crc)){
+        ok = false;
+    }
+
+    //the record of unzip points into the old zip, like for the added files only the name is kept
+    if(ok){
+        this->p->fileInfos.insert(fileName);
+    }
 
     return ok;
 }
 
 bool Zip::cleanUpAfterCopying(bool ok, const std::string& tempZipFile)
 {
+    if(this->p->buffer != NULL){
+        if(! ok){
+            //restore the old zip
+            close();
+            this->p->buffer->swap(this->p->tempBuffer);
+        }
+
+        std::vector<unsigned char>().swap(this->p->tempBuffer);
+        return true;
+    }
+
     if(! ok){
         close();
 
@@ -668,10 +1326,18 @@ bool Zip::cleanUpAfterCopying(bool ok, const std::string& tempZipFile)
 
 void Zip::restoreTheOldOpenStatus(OpenFlags::Flags oldOpenState)
 {
-    if(oldOpenState == OpenFlags::OpenExisting){
-        close();
-        open(this->p->zipFileName, oldOpenState);
+    if(oldOpenState != OpenFlags::OpenExisting){
+        return;
+    }
+
+    //the new zip is still opened and its file infos are up to date,
+    //so it is used further, without reading the zip again
+    if(isOpened()){
+        this->p->openFlag = oldOpenState;
+        return;
     }
+
+    reopen(oldOpenState);
 }
 
 bool Zip::deleteFolder(const std::string& folderName)
@@ -693,35 +1359,16 @@ bool Zip::deleteFolders(const std::list<std::string>& folderNames)
         folderNamesToDelete.push_back(folderName);
     }
 
-    if(! isOpened()){
+    if(! isOpened() || isFileWriterOpened()){
         return false;
     }
 
-    //remember the openFlag
-    enum OpenFlags::Flags oldOpenFlag = this->p->openFlag;
-
     //check if a file or a folder with the name of fileName exists
     if(! containsAnyFile(folderNamesToDelete)){
         return true;
     }
 
-    //close the current zip
-    close();
-
-    //move the current zip to an tempzip
-    std::string tempZipFile = moveTheCurrentZipToAnTempZip();
-    if(tempZipFile.empty()){
-        return false;
-    }
-
-    //Copy all files and folders into a new zip file, except the fileName
-    bool ok = copyAllFilesAndFoldersIntoANewZipFileExceptTheFileNames(tempZipFile, folderNamesToDelete, true);
-    cleanUpAfterCopying(ok, tempZipFile);
-
-    //restore the old open status if necessary
-    restoreTheOldOpenStatus(oldOpenFlag);
-
-    return ok;
+    return rewrite_internal(std::list<std::string>(), folderNamesToDelete);
 }
 
 bool Zip::replaceFile(const std::string& fileName, std::vector<unsigned char>& content)
@@ -753,6 +1400,77 @@ bool Zip::replaceFile(const std::string& fileName, const std::string& destFileNa
 
 }
 
+bool Zip::commit(const ZipTransaction& transaction)
+{
+    if(! isOpened() || isFileWriterOpened()){
+        return false;
+    }
+
+    const ZipTransactionPrivate& changes = *transaction.p;
+    std::unordered_set<std::string> fileNamesToDelete(changes.fileNamesToDelete.begin(),
+                                                      changes.fileNamesToDelete.end());
+
+    auto isDeleted = [&](const std::string& fileName){
+        return fileNamesToDelete.count(fileName) == 1 ||
+               std::any_of(changes.folderNamesToDelete.cbegin(), changes.folderNamesToDelete.cend(),
+                           [&](const std::string& folderName){
+            return boost::algorithm::starts_with(fileName, folderName);
+        });
+    };
+
+    //a new file must not exist inside the zip, except it is deleted before
+    for(const auto& file : changes.filesToAdd){
+        if(containsFile(file.fileName) && ! isDeleted(file.fileName)){
+            return false;
+        }
+    }
+
+    //nothing to remove: no need to rewrite the zip
+    if(! containsAnyFile(changes.fileNamesToDelete) && ! containsAnyFile(changes.folderNamesToDelete)){
+        return addTransactionFiles_internal(changes);
+    }
+
+    return rewrite_internal(changes.fileNamesToDelete, changes.folderNamesToDelete, &changes);
+}
+
+bool Zip::addTransactionFiles_internal(const ZipTransactionPrivate& transaction)
+{
+    std::vector<PendingEntry> entries;
+
+    //the files from the file system are added together, to compress them in parallel
+    auto addEntries = [&](){
+        bool ok = entries.empty() || addEntries_internal(entries, true);
+        entries.clear();
+        return ok;
+    };
+
+    for(const auto& file : transaction.filesToAdd){
+        if(! file.isFromFileSystem){
+            if(! addEntries() || ! addFile_internal(getFileInfoForANewFile(file.fileName), file.content)){
+                return false;
+            }
+            continue;
+        }
+
+        try{
+            std::shared_ptr<InnerZipFileInfo> info = getFileInfoForAExistingFile(file.sourceFileName);
+            info->fileName = file.fileName;
+
+            boost::system::error_code error;
+            unsigned long long size = boost::filesystem::file_size(file.sourceFileName, error);
+            if(error){
+                return false;
+            }
+
+            entries.push_back(PendingEntry(info, file.sourceFileName, size, false));
+        } catch(std::exception& e){
+            return false;
+        }
+    }
+
+    return addEntries();
+}
+
 //bool Zip::addFilter(std::string filter)
 //{
 //    return false;
@@ -764,6 +1482,11 @@ bool Zip::close()
         return true;
     }
 
+    //the file of an opened writer has to be finished first
+    if(isFileWriterOpened() && ! this->p->fileWriter->close()){
+        return false;
+    }
+
     if(ZIP_OK == zipClose(this->p->zipfile_handle, NULL)){
         clear();
         return true;
@@ -794,6 +1517,30 @@ size_t Zip::getCompressionLevel()
     return this->p->compressionLevel;
 }
 
+bool Zip::setNumberOfThreads(unsigned int numThreads)
+{
+    if(numThreads == 0){
+        return false;
+    }
+
+    if(numThreads != this->p->numThreads){
+        this->p->threadPool.reset();
+
+        if(numThreads > 1){
+            this->p->threadPool = std::make_shared<ThreadPool>(numThreads);
+        }
+    }
+
+    this->p->numThreads = numThreads;
+
+    return true;
+}
+
+unsigned int Zip::getNumberOfThreads()
+{
+    return this->p->numThreads;
+}
+
 bool Zip::createFolderIfNotExists(const std::string& path)
 {
     std::string pathToCreate = path;
@@ -43,8 +43,8 @@
 
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <memory>
+#include <iosfwd>
 #include <boost/signals2.hpp>
 
 /*!
@@ -53,8 +53,14 @@
 namespace cppzip {
 //forward declaration
 struct InnerZipFileInfo;
+class FileInfoIndex;
+struct PendingEntry;
+struct DeflatedData;
 class Unzip;
 class ZipPrivate;
+class ZipFileWriter;
+class ZipTransaction;
+class ZipTransactionPrivate;
 
 /*!
  * \brief Zip allows creating zip files
@@ -91,6 +97,31 @@ public:
               const OpenFlags::Flags& flag = OpenFlags::CreateAndOverwrite,
               const std::string& password = "");
 
+    /*!
+     * \brief Opens a zip in memory.
+     *
+     * The zip is written into buffer, no file is created. The buffer grows
+     * while files are added. When close() is called, buffer contains the
+     * complete zip file.
+     *
+     * If
+     * - flag == \ref OpenFlags::Flags "OpenFlags::CREATE_AND_OVERWRITE" then buffer is cleared
+     *           and a new zip is created.
+     * - flag == \ref OpenFlags::Flags "OpenFlags::OPEN_EXISTING" then buffer contains an existing
+     *           zip file, to delete, replace or add files.
+     *
+     * buffer has to stay valid until the zip is closed.
+     *
+     * \param buffer   is the memory for the zip.
+     * \param flag     is the flag that controls, how the zip class works.
+     * \param password is the password which protects the files within the zip.
+     *
+     * \return true if the zip is opened, otherwise false.
+     */
+    bool open(std::vector<unsigned char>& buffer,
+              const OpenFlags::Flags& flag = OpenFlags::CreateAndOverwrite,
+              const std::string& password = "");
+
     /*!
      * \brief Gets the opened status.
      *
@@ -175,6 +206,13 @@ public:
      *
      * Adds the content of the files into new files inside the zip.
      *
+     * If more than one thread is set (see setNumberOfThreads()), the files
+     * are compressed in parallel into memory and written in the order of
+     * fileNames into the zip. The zip is the same byte for byte as with one
+     * thread, as long as no file is larger than 4 MiB. A larger file is
+     * compressed block wise in parallel (like pigz), its compressed
+     * data differs from the data compressed with one thread.
+     *
      * If a file in fileNames is empty, an empty file will be created inside the zip file.
      * If a file in fileNames doesn't exist or can't read, false is returned, but it tries
      * to add as much files as possible and don't break at a failure.
@@ -216,6 +254,13 @@ public:
      *
      * If the folder already exists addFolder() == false, and nothing will be added.
      *
+     * If more than one thread is set (see setNumberOfThreads()), the files
+     * are compressed in parallel into memory and written in the same order
+     * into the zip, as with one thread. The zip is the same byte for byte as
+     * with one thread, as long as no file is larger than 4 MiB. A larger file
+     * is compressed block wise in parallel (like pigz), its compressed
+     * data differs from the data compressed with one thread.
+     *
      * \note At the moment there are problems with umlauts in fileName (ä, ö, ü, ..)
      *
      * \param folderName is the folder to add inside the zip file.
@@ -252,6 +297,23 @@ public:
      */
     bool addEmptyFolder(const std::string& folderName);
 
+    /*!
+     * \brief Opens a writer that adds a new file, whose content is written piece by piece.
+     *
+     * Use it for content that is generated on the fly and shouldn't be held
+     * in memory as a whole. Only one writer can be opened at a time. Until the
+     * writer is closed, the other operations that change the zip fail.
+     * close() of the zip closes an opened writer. See ZipFileWriter for an example.
+     *
+     * \param fileName is the file to add inside the zip file.
+     * \param largeFile must be true, if the content can be 4 GiB or more
+     *                  (the file is then written with zip64 extensions).
+     *
+     * \return the opened writer, or an empty pointer if the file already exists,
+     *         another writer is opened or the file couldn't be opened.
+     */
+    std::shared_ptr<ZipFileWriter> openFileWriter(const std::string& fileName, bool largeFile = false);
+
     /*!
      * \brief     Deletes a file inside the zip.
      *
@@ -297,6 +359,43 @@ public:
      */
     bool deleteFolders(const std::list<std::string>& folderNames);
 
+    /*!
+     * \brief     Deletes a file inside the zip, without rewriting the zip.
+     *
+     * See fastDeleteFiles().
+     *
+     * \param     fileName is the file that should be removed from the zip file.
+     *
+     * \return    true if the file is deleted, otherwise false.
+     */
+    bool fastDeleteFile(const std::string& fileName);
+
+    /*!
+     * \brief     Deletes all files specified in fileNames inside the zip, without rewriting the zip.
+     *
+     * Only the central directory is written again, without the entries of
+     * fileNames. The content of the deleted files stays as a hole inside the
+     * zip file, until compact() is called. So the operation is fast, also on
+     * big zip files. A folder is deleted with its name (e.g. "folder/"), the
+     * files inside the folder aren't deleted.
+     *
+     * \param     fileNames is a list of files that should be removed from the zip file.
+     *
+     * \return    true if the files are deleted, otherwise false.
+     */
+    bool fastDeleteFiles(const std::list<std::string>& fileNames);
+
+    /*!
+     * \brief     Removes the holes left by fastDeleteFiles().
+     *
+     * All files are copied (without recompressing them) into a new zip file.
+     *
+     * \attention The compact operation may be slow on big zip files.
+     *
+     * \return    true if the zip is compacted, otherwise false.
+     */
+    bool compact();
+
     /*!
      * \brief Replaces the existing file inside the zip file with given the content.
      *
@@ -329,6 +428,26 @@ public:
      */
     bool replaceFile(const std::string& fileName, const std::string& destFileName);
 
+    /*!
+     * \brief Applies all changes collected by the transaction to the zip.
+     *
+     * The zip is rewritten only once for all deletes and replaces: the files
+     * that stay inside the zip are copied (without recompressing them) and the
+     * new files are added after them. If no file inside the zip is deleted or
+     * replaced, the new files are only added.
+     *
+     * If a new file (not a replaced one) already exists inside the zip, nothing
+     * is changed and false is returned. If a change fails while the zip is
+     * rewritten, the old zip is restored.
+     *
+     * See ZipTransaction for an example.
+     *
+     * \param  transaction contains the changes.
+     *
+     * \return true if all changes are applied, otherwise false.
+     */
+    bool commit(const ZipTransaction& transaction);
+
     //bool addFilter(std::string filter); //??
 
     /*!
@@ -354,6 +473,32 @@ public:
      */
     size_t getCompressionLevel();
 
+    /*!
+     * \brief Sets the number of threads used to compress large files.
+     *
+     * If numThreads > 1, files from the file system that are larger than
+     * one compression block (128 KiB) are split into blocks, which are
+     * compressed in parallel (like pigz). The result is still one standard
+     * deflate stream inside the zip, readable by any unzip tool.
+     *
+     *  - 1 = compress with the calling thread only
+     *  - default = 1
+     *
+     * \param numThreads is the number of threads used for compression.
+     * \return true if numThreads could set, otherwise false (numThreads == 0).
+     *
+     * \see getNumberOfThreads()
+     */
+    bool setNumberOfThreads(unsigned int numThreads);
+
+    /*!
+     * \brief Gets the number of threads used for compression.
+     *
+     * \return the number of threads.
+     * \see setNumberOfThreads()
+     */
+    unsigned int getNumberOfThreads();
+
     /*!
      * \brief Closes the zip file.
      *
@@ -393,18 +538,22 @@ private:
     /*!
      * Retrieves the file infos of an existing zip file.
      *
-     * If the file doesn't exist or an error occurs, an empty map will be returned;
+     * If the file doesn't exist or an error occurs, fileInfos will be empty.
      *
-     * \return the zip file infos.
+     * \param fileInfos gets the zip file infos.
      */
-    std::unordered_map<std::string, std::shared_ptr<InnerZipFileInfo> >
-        retrieveFileInfos(const std::string& fileName);
+    void retrieveFileInfos(const std::string& fileName, FileInfoIndex& fileInfos);
 
     /*!
      * Clears the internal members.
      */
     void clear();
 
+    /*!
+     * Checks if a ZipFileWriter has a file inside the zip opened.
+     */
+    bool isFileWriterOpened();
+
     // Helpers for adding file/folder
     /*!
      * Creates a folder on the file system with all subfolders if not exists
@@ -416,7 +565,6 @@ private:
 
     std::shared_ptr<InnerZipFileInfo> getFileInfoForANewFile(const std::string& fileName);
     std::shared_ptr<InnerZipFileInfo> getFileInfoForAExistingFile(const std::string& fileName);
-    std::shared_ptr<InnerZipFileInfo> getFileInfoFromLocalFileInfos(const std::string& fileName);
 
     /*!
      * Gets the platform depended file attributes from an exiting file on the file system.
@@ -433,35 +581,112 @@ private:
             std::shared_ptr<InnerZipFileInfo> info,
             const std::string& fileName);
 
+    /*!
+     * Compresses the content of input in parallel (see setNumberOfThreads())
+     * and writes the result as raw data into the zip.
+     */
+    bool addLargeFile_internal(
+            std::shared_ptr<InnerZipFileInfo> info,
+            std::istream& input,
+            unsigned long long size);
+
     bool containsFile(const std::string& fileName);
     bool containsAnyFile(const std::list<std::string>& fileNames);
 
     bool addFolder(
             const std::string& realFolderName, const std::string& relativeFolderName,
             bool preservePath = true, bool recursive = true);
-    bool addFolderChilds(
-                const std::string& realFolderName, const std::string& folderNameToAdd,
-                bool preservePath = true, bool recursive = true);
+    void collectFolderEntries(
+                const std::string& realFolderName, const std::string& relativeFolderName,
+                bool preservePath, bool recursive,
+                std::vector<PendingEntry>& entries);
     bool addFolder_internal(std::shared_ptr<InnerZipFileInfo> info);
 
+    /*!
+     * Adds the entries in the given order into the zip. If more than one thread
+     * is set, the files are compressed in parallel into memory and the compressed
+     * data is written raw into the zip.
+     *
+     * \param entries are the files and folders to add.
+     * \param stopAtFirstFailure controls, if the remaining entries are added after a failure.
+     * \return true if all entries are added, otherwise false.
+     */
+    bool addEntries_internal(const std::vector<PendingEntry>& entries, bool stopAtFirstFailure);
+    bool addEntry_internal(const PendingEntry& entry);
+    bool addDeflatedFile_internal(
+            std::shared_ptr<InnerZipFileInfo> info,
+            const DeflatedData& deflatedData);
+
+    /*!
+     * Adds the files of a transaction in the order they were collected.
+     *
+     * \return true if all files are added, otherwise false.
+     */
+    bool addTransactionFiles_internal(const ZipTransactionPrivate& transaction);
+
     // Helpers for deleting file/folder
     /*!
-     * Moves the current zip to an temp zip.
+     * Rewrites the zip: copies all files and folders into a new zip, except the
+     * files in fileNames and the folders (incl. files) in folderNames. Then the
+     * files of transaction are added, if it isn't NULL. If something fails, the
+     * old zip is restored. Then the old open status is restored.
      *
-     * \return the name of the file name if successfully moved, otherwise an empty string.
+     * \return true if all is ok, otherwise false.
      */
-    std::string moveTheCurrentZipToAnTempZip();
+    bool rewrite_internal(const std::list<std::string>& fileNames,
+                          const std::list<std::string>& folderNames,
+                          const ZipTransactionPrivate* transaction = NULL);
 
     /*!
-     * Copies all files and folders into a new zip, except the files in fileNames.
+     * Writes the central directory of the closed zip again, without the
+     * entries in fileNames. The zip file is cut after the new central directory.
+     *
+     * \return true if all is ok, otherwise false.
+     */
+    bool rewriteCentralDirectoryWithout(const std::list<std::string>& fileNames);
+
+    /*!
+     * Moves the current zip to an temp zip. A zip in memory is moved into p->tempBuffer.
+     *
+     * \param tempZipFile is set to the file name of the temp zip (empty for a zip in memory).
+     * \return true if successfully moved, otherwise false.
+     */
+    bool moveTheCurrentZipToAnTempZip(std::string& tempZipFile);
+
+    /*!
+     * Opens again the zip file or the zip in memory with flag.
+     *
+     * \return true if the zip is opened, otherwise false.
+     */
+    bool reopen(const OpenFlags::Flags& flag);
+
+    /*!
+     * Opens again the zip file or the zip in memory to add files. The file
+     * infos aren't read from the zip again, fileInfos are taken instead.
+     *
+     * \return true if the zip is opened, otherwise false.
+     */
+    bool reopenToAppend(FileInfoIndex& fileInfos);
+
+    /*!
+     * Copies all files and folders into a new zip, except the files in fileNames
+     * and the folders (incl. files) in folderNames.
      *
      * \return true if all is ok, otherwise false.
      */
     bool copyAllFilesAndFoldersIntoANewZipFileExceptTheFileNames(const std::string& tempZipFile,
                                                                  const std::list<std::string>& fileNames,
-                                                                 bool areFileNamesFolders);
+                                                                 const std::list<std::string>& folderNames);
 
-    bool copyFile(Unzip& unzip, const std::string& fileName);
+    /*!
+     * Copies the file raw from unzip into the zip. The compressed content, an
+     * encryption header, the method, the flags, the extra fields and the
+     * attributes are taken over as they are. Nothing is decompressed or compressed.
+     *
+     * \param buffer is used to copy the content.
+     * \return true if the file is copied, otherwise false.
+     */
+    bool copyFile(Unzip& unzip, const std::string& fileName, std::vector<unsigned char>& buffer);
 
     /*!
      * Cleans up the temporary files and tries to restore the original zip file.
@@ -471,7 +696,8 @@ private:
     bool cleanUpAfterCopying(bool ok, const std::string& tempZipFile);
 
     /*!
-     * Restores the old open status, with the zip file was opened.
+     * Restores the old open status, with the zip file was opened. If the new
+     * zip is still opened after the rewrite, it is kept opened.
      */
     void restoreTheOldOpenStatus(OpenFlags::Flags oldOpenState);
 
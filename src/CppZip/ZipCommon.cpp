@@ -16,6 +16,8 @@ InnerZipFileInfo::InnerZipFileInfo()
     uncompressed_size = 0;
     internal_fileAttributes = 0;
     external_fileAttributes = 0;
+    posInZipDirectory = 0;
+    numOfFile = 0;
 }
 
 } //cppzip
@@ -68,6 +68,9 @@ struct InnerZipFileInfo
 
     unsigned long internal_fileAttributes;
     unsigned long external_fileAttributes;
+
+    unsigned long long posInZipDirectory;     /* offset of the entry in the central directory (unz64_file_pos) */
+    unsigned long long numOfFile;             /* index of the entry in the central directory (unz64_file_pos) */
 };
 
 } //cppzip
@@ -50,6 +50,29 @@ public:
     };
 };
 
+/*! \brief Read modes */
+class CPPZIP_SHARED_EXPORT ReadModes {
+public:
+    /*! \brief Read modes */
+    enum Modes {
+        Stream              //!< \brief Reads the zip file with fseek/fread (stdio).
+       ,MemoryMapped        //!< \brief Maps the zip file into memory and reads from the page cache.
+    };
+};
+
+/*! \brief Index modes */
+class CPPZIP_SHARED_EXPORT IndexModes {
+public:
+    /*! \brief Index modes */
+    enum Modes {
+        Eager               //!< \brief Reads the infos of all files when the zip is opened.
+       ,Lazy                //!< \brief Reads only the end of the central directory when the zip is opened.
+                            //!< The infos of the files are read when they are needed the first time.
+       ,IndexFile           //!< \brief Loads the infos of the files from an index file when the zip is opened.
+                            //!< The index file is created, if it is missing or out of date.
+    };
+};
+
 } //cppzip
 
 #endif /* ZIPDEFINES_H_ */
@@ -0,0 +1,114 @@
+/*
+ * ZipFileWriter.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "ZipFileWriter.h"
+#include "ZipPrivate.h"
+#include "minizip/zip.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace cppzip {
+
+ZipFileWriter::ZipFileWriter()
+: p(new ZipFileWriterPrivate())
+{
+
+}
+
+ZipFileWriter::~ZipFileWriter()
+{
+    close();
+    delete p;
+    p = NULL;
+}
+
+bool ZipFileWriter::isOpened()
+{
+    return this->p->zip != NULL;
+}
+
+bool ZipFileWriter::write(const unsigned char* data, size_t size)
+{
+    if(! isOpened()){
+        return false;
+    }
+
+    while(size > 0){
+        //zipWriteInFileInZip() takes at most an unsigned int per call
+        unsigned int chunk = static_cast<unsigned int>(
+                std::min(size, static_cast<size_t>(INT_MAX)));
+
+        if(ZIP_OK != zipWriteInFileInZip(this->p->zip->zipfile_handle, data, chunk)){
+            return false;
+        }
+
+        data += chunk;
+        size -= chunk;
+        this->p->bytesWritten += chunk;
+    }
+
+    return true;
+}
+
+bool ZipFileWriter::write(const std::vector<unsigned char>& content)
+{
+    return write(content.data(), content.size());
+}
+
+bool ZipFileWriter::close()
+{
+    if(! isOpened()){
+        return true;
+    }
+
+    ZipPrivate* zip = this->p->zip;
+    this->p->zip = NULL;
+    zip->fileWriter = NULL;
+
+    zip->fileInfos.insert(this->p->info->fileName);
+
+    return ZIP_OK == zipCloseFileInZip(zip->zipfile_handle);
+}
+
+std::string ZipFileWriter::getFileName()
+{
+    return this->p->info->fileName;
+}
+
+unsigned long long ZipFileWriter::getBytesWritten()
+{
+    return this->p->bytesWritten;
+}
+
+} //cppzip
@@ -0,0 +1,139 @@
+/*!
+ * \file ZipFileWriter.h
+ *
+ * ZipFileWriter.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_ZIPFILEWRITER_H_
+#define CPPZIP_ZIPFILEWRITER_H_
+
+#include "CppZip_Global.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cppzip {
+//forward declaration
+class Zip;
+class ZipFileWriterPrivate;
+
+/*!
+ * \brief ZipFileWriter writes the content of a file inside a zip piece by piece.
+ *
+ * The content is compressed while it is written, so content of any size can be
+ * added without holding it in memory as a whole. A writer is created with
+ * Zip::openFileWriter(). Only one writer can be opened per zip file at a time.
+ * While it is opened, the other operations that change the zip fail.
+ *
+ * This is a usage example:
+ * \code
+ *  Zip zip;
+ *  zip.open("file.zip");
+ *
+ *  std::shared_ptr<ZipFileWriter> writer = zip.openFileWriter("report.txt");
+ *
+ *  while(hasMoreLines()){
+ *      std::string line = nextLine();
+ *      writer->write((const unsigned char*)line.data(), line.size());
+ *  }
+ *
+ *  bool ok = writer->close();
+ *  zip.close();
+ * \endcode
+ */
+class CPPZIP_SHARED_EXPORT ZipFileWriter {
+public:
+    /*!
+     * \brief Closes the writer, if not closed already.
+     */
+    ~ZipFileWriter();
+
+    /*!
+     * \brief Checks if the writer is opened.
+     *
+     * \return true if the writer is opened, otherwise false.
+     */
+    bool isOpened();
+
+    /*!
+     * \brief Appends data to the content of the file.
+     *
+     * \param data is the data to write.
+     * \param size is the number of bytes to write.
+     *
+     * \return true if data could be written, otherwise false.
+     */
+    bool write(const unsigned char* data, size_t size);
+
+    /*!
+     * \brief Appends content to the content of the file.
+     *
+     * \param content is the data to write.
+     *
+     * \return true if content could be written, otherwise false.
+     */
+    bool write(const std::vector<unsigned char>& content);
+
+    /*!
+     * \brief Closes the writer and finishes the file inside the zip.
+     *
+     * After close() other files can be added to the zip again.
+     *
+     * \return true if the file could be finished, otherwise false.
+     */
+    bool close();
+
+    /*!
+     * \brief Gets the name of the file inside the zip.
+     */
+    std::string getFileName();
+
+    /*!
+     * \brief Gets the number of bytes written so far.
+     */
+    unsigned long long getBytesWritten();
+
+private:
+    friend class Zip;
+
+    ZipFileWriter();
+    ZipFileWriter(const ZipFileWriter&);
+    ZipFileWriter& operator=(const ZipFileWriter&);
+
+private:
+    ZipFileWriterPrivate* p;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_ZIPFILEWRITER_H_ */
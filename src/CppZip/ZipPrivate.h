@@ -35,15 +35,28 @@
 #ifndef CPPZIP_ZIPPRIVATE_H_
 #define CPPZIP_ZIPPRIVATE_H_
 
+#include <atomic>
+#include <list>
+#include <map>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
+#include "CentralDirectory.h"
+#include "FileInfoIndex.h"
 #include "ZipDefines.h"
 #include "ZipCommon.h"
 #include "minizip/zip.h"
 
 namespace cppzip{
 
+    //forward declaration
+    class CheckpointIndex;
+    class ThreadPool;
+    class ZipFileWriter;
+    struct MemoryRegion;
+
     /*!
      * \brief  Converts a InnerZipFileInfo to a zip_fileinfo.
      *
@@ -71,12 +84,38 @@ namespace cppzip{
      */
     const char* formatPassword(const std::string& password);
 
+    /*!
+     * \brief An entry that is collected to be added into the zip.
+     */
+    struct PendingEntry
+    {
+        PendingEntry(std::shared_ptr<InnerZipFileInfo> info,
+                     const std::string& fileName,
+                     unsigned long long size,
+                     bool isFolder)
+            : info(info)
+            , fileName(fileName)
+            , size(size)
+            , isFolder(isFolder)
+        {}
+
+        std::shared_ptr<InnerZipFileInfo> info;
+        std::string fileName;                 /* the file (or folder) on the file system */
+        unsigned long long size;              /* the size of the file on the file system */
+        bool isFolder;
+    };
+
     class UnzipPrivate
     {
     public:
         UnzipPrivate()
         : zipfile_handle(NULL)
          , numFiles(0)
+         , indexMode(IndexModes::Eager)
+         , fileInfosRetrieved(false)
+         , numThreads(1)
+         , bytesExtracted(0)
+         , bytesToExtract(0)
         {}
 
         typedef void* voidp;
@@ -85,10 +124,48 @@ namespace cppzip{
         unzFile zipfile_handle;
         int numFiles;
 
-        typedef std::pair<std::string, InnerZipFileInfo> FileInfoPair;
-        std::unordered_map<std::string, std::shared_ptr<InnerZipFileInfo>> fileInfos;
+        FileInfoIndex fileInfos;
+        IndexModes::Modes indexMode;
+        std::string indexFileName;            /* empty for the default name */
+        std::atomic<bool> fileInfosRetrieved; /* false until the file infos are read */
+        std::mutex fileInfosMutex;            /* several threads can need the file infos */
+
+        ReadAt readAt;                        /* positional reads for the EntryReader's, empty if not possible */
+        std::mutex handleMutex;               /* zipfile_handle has a current file, so it is used by one thread only */
 
+        std::map<std::string, std::shared_ptr<const CheckpointIndex> > checkpointIndexes;
+        std::mutex checkpointIndexesMutex;
+
+        std::string zipFileName;
         std::string password;
+
+        std::shared_ptr<MemoryRegion> memoryRegion;   /* the zip file in memory, if not read with stdio */
+
+        unsigned int numThreads;
+        std::mutex signalMutex;
+        unsigned long long bytesExtracted;    /* for extractionProgress, guarded by signalMutex */
+        unsigned long long bytesToExtract;
+    };
+
+    class UnzipFileReaderPrivate
+    {
+    public:
+        UnzipFileReaderPrivate()
+            : zipfile_handle(NULL)
+            , fileSize(0)
+            , bytesRead(0)
+            , endOfFile(false)
+        {}
+
+        typedef void* voidp;
+        typedef voidp unzFile;
+
+        unzFile zipfile_handle;               /* own handle, the current file is opened */
+        std::shared_ptr<MemoryRegion> memoryRegion;   /* keeps the memory of the handle alive */
+        std::string fileName;
+        unsigned long long fileSize;
+        unsigned long long bytesRead;
+        bool endOfFile;
     };
 
     class ZipPrivate
@@ -98,17 +175,68 @@ namespace cppzip{
             : zipfile_handle(NULL)
             , openFlag(OpenFlags::CreateAndOverwrite)
             , compressionLevel(Z_DEFAULT_COMPRESSION)
+            , numThreads(1)
+            , fileWriter(NULL)
+            , buffer(NULL)
         {}
 
         typedef void* voidp;
         typedef voidp zipFile;
         std::string zipFileName;
-        std::unordered_map<std::string, std::shared_ptr<InnerZipFileInfo>> fileInfos;
+
+        //Zip only looks up the names, the added and copied files have empty records,
+        //the records taken over from Unzip describe the zip as it was opened
+        FileInfoIndex fileInfos;
 
         zipFile zipfile_handle;
         OpenFlags::Flags openFlag;
         int compressionLevel;
         std::string password;
+
+        unsigned int numThreads;
+        std::shared_ptr<ThreadPool> threadPool;
+
+        ZipFileWriter* fileWriter;            /* the opened writer, NULL if there is none */
+
+        std::vector<unsigned char>* buffer;   /* the zip in memory, NULL if the zip is a file */
+        std::vector<unsigned char> tempBuffer;    /* the old zip while files are deleted in memory */
+    };
+
+    class ZipFileWriterPrivate
+    {
+    public:
+        ZipFileWriterPrivate()
+            : zip(NULL)
+            , bytesWritten(0)
+        {}
+
+        ZipPrivate* zip;                      /* the zip with the opened file, NULL if closed */
+        std::shared_ptr<InnerZipFileInfo> info;
+        unsigned long long bytesWritten;
+    };
+
+    /*!
+     * \brief A file that is added into the zip by a ZipTransaction.
+     */
+    struct TransactionFile
+    {
+        TransactionFile()
+            : isFromFileSystem(false)
+        {}
+
+        std::string fileName;                 /* the file inside the zip */
+        std::string sourceFileName;           /* the file on the file system */
+        std::vector<unsigned char> content;   /* the content, if not from the file system */
+        bool isFromFileSystem;
+    };
+
+    class ZipTransactionPrivate
+    {
+    public:
+        std::vector<TransactionFile> filesToAdd;          /* in the order they are added */
+        std::unordered_set<std::string> fileNamesToAdd;
+        std::list<std::string> fileNamesToDelete;         /* incl. the replaced files */
+        std::list<std::string> folderNamesToDelete;       /* each ends with "/" */
     };
 
 } //cppzip
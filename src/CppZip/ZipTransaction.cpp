@@ -0,0 +1,142 @@
+/*
+ * ZipTransaction.cpp -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#include "ZipTransaction.h"
+#include "ZipPrivate.h"
+
+#include <boost/algorithm/string.hpp>
+
+namespace cppzip {
+
+ZipTransaction::ZipTransaction()
+: p(new ZipTransactionPrivate())
+{
+
+}
+
+ZipTransaction::~ZipTransaction()
+{
+    delete p;
+    p = NULL;
+}
+
+bool ZipTransaction::addFile(const std::string& fileName, const std::vector<unsigned char>& content)
+{
+    if(fileName.length() == 0 || ! this->p->fileNamesToAdd.insert(fileName).second){
+        return false;
+    }
+
+    TransactionFile file;
+    file.fileName = fileName;
+    file.content = content;
+    this->p->filesToAdd.push_back(file);
+
+    return true;
+}
+
+bool ZipTransaction::addFile(const std::string& fileName, const std::string& destFileName)
+{
+    if(destFileName.length() == 0 || ! this->p->fileNamesToAdd.insert(destFileName).second){
+        return false;
+    }
+
+    TransactionFile file;
+    file.fileName = destFileName;
+    file.sourceFileName = fileName;
+    file.isFromFileSystem = true;
+    this->p->filesToAdd.push_back(file);
+
+    return true;
+}
+
+bool ZipTransaction::replaceFile(const std::string& fileName, const std::vector<unsigned char>& content)
+{
+    if(! addFile(fileName, content)){
+        return false;
+    }
+
+    return deleteFile(fileName);
+}
+
+bool ZipTransaction::replaceFile(const std::string& fileName, const std::string& destFileName)
+{
+    if(! addFile(fileName, destFileName)){
+        return false;
+    }
+
+    return deleteFile(destFileName);
+}
+
+bool ZipTransaction::deleteFile(const std::string& fileName)
+{
+    if(fileName.length() == 0){
+        return false;
+    }
+
+    this->p->fileNamesToDelete.push_back(fileName);
+
+    return true;
+}
+
+bool ZipTransaction::deleteFolder(const std::string& folderName)
+{
+    if(folderName.length() == 0){
+        return false;
+    }
+
+    std::string folderNameToDelete = folderName;
+    if(! boost::algorithm::ends_with(folderNameToDelete, "/")){
+        folderNameToDelete += "/";
+    }
+
+    this->p->folderNamesToDelete.push_back(folderNameToDelete);
+
+    return true;
+}
+
+bool ZipTransaction::isEmpty()
+{
+    return this->p->filesToAdd.empty() &&
+           this->p->fileNamesToDelete.empty() &&
+           this->p->folderNamesToDelete.empty();
+}
+
+void ZipTransaction::clear()
+{
+    this->p->filesToAdd.clear();
+    this->p->fileNamesToAdd.clear();
+    this->p->fileNamesToDelete.clear();
+    this->p->folderNamesToDelete.clear();
+}
+
+} //cppzip
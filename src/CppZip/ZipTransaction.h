@@ -0,0 +1,174 @@
+/*!
+ * \file ZipTransaction.h
+ *
+ * ZipTransaction.h -- IO on .zip files using minizip and zlib
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_ZIPTRANSACTION_H_
+#define CPPZIP_ZIPTRANSACTION_H_
+
+#include "CppZip_Global.h"
+
+#include <string>
+#include <vector>
+
+namespace cppzip {
+//forward declaration
+class Zip;
+class ZipTransactionPrivate;
+
+/*!
+ * \brief ZipTransaction collects changes, which are applied at once to a zip.
+ *
+ * Each deleteFile() or replaceFile() of Zip rewrites the whole zip file. A
+ * transaction collects adds, replaces and deletes and Zip::commit() applies
+ * all of them with only one rewrite: the files that stay inside the zip are
+ * copied once and the new files are added after them. If nothing has to be
+ * removed from the zip, the new files are only added, without a rewrite.
+ *
+ * The changes refer to the files inside the zip before the commit. If one
+ * change fails, the zip stays as it was before the commit.
+ *
+ * This is a usage example:
+ * \code
+ *  Zip zip;
+ *  zip.open("file.zip", OpenFlags::OpenExisting);
+ *
+ *  ZipTransaction transaction;
+ *  transaction.replaceFile("data/config.xml", "config.xml");
+ *  transaction.replaceFile("version.txt", content);
+ *  transaction.deleteFile("old.txt");
+ *  transaction.deleteFolder("cache");
+ *  transaction.addFile("new.txt", "data/new.txt");
+ *
+ *  bool ok = zip.commit(transaction);
+ *  zip.close();
+ * \endcode
+ */
+class CPPZIP_SHARED_EXPORT ZipTransaction {
+public:
+    ZipTransaction();
+    ~ZipTransaction();
+
+    /*!
+     * \brief Adds the content into a new fileName inside the zip.
+     *
+     * The content is copied into the transaction.
+     *
+     * \param fileName is the file to add inside the zip file.
+     * \param content is the content of the file.
+     *
+     * \return true if the file is collected, otherwise false (fileName is
+     *         empty or is already added by the transaction).
+     */
+    bool addFile(const std::string& fileName, const std::vector<unsigned char>& content);
+
+    /*!
+     * \brief Adds a file from the file system into a new file destFileName inside the zip.
+     *
+     * The file is read at the commit.
+     *
+     * \param fileName is the file to add (must exist on file system at the commit).
+     * \param destFileName is the destination file name inside the zip.
+     *
+     * \return true if the file is collected, otherwise false (destFileName is
+     *         empty or is already added by the transaction).
+     */
+    bool addFile(const std::string& fileName, const std::string& destFileName);
+
+    /*!
+     * \brief Replaces the file fileName inside the zip with the content.
+     *
+     * If the fileName doesn't exist inside the zip, the file will be added.
+     *
+     * \param fileName is the file that should be replaced inside the zip file.
+     * \param content is the new content of fileName.
+     *
+     * \return true if the file is collected, otherwise false.
+     */
+    bool replaceFile(const std::string& fileName, const std::vector<unsigned char>& content);
+
+    /*!
+     * \brief Replaces the file destFileName inside the zip with the content of the file.
+     *
+     * If the destFileName doesn't exist inside the zip, the file will be added.
+     *
+     * \param fileName is the file to add (must exist on file system at the commit).
+     * \param destFileName is the destination file name inside the zip that should be replaced.
+     *
+     * \return true if the file is collected, otherwise false.
+     */
+    bool replaceFile(const std::string& fileName, const std::string& destFileName);
+
+    /*!
+     * \brief Deletes a file inside the zip.
+     *
+     * \param fileName is the file that should be removed from the zip file.
+     *
+     * \return true if the file is collected, otherwise false (fileName is empty).
+     */
+    bool deleteFile(const std::string& fileName);
+
+    /*!
+     * \brief Deletes a folder incl. files inside the zip.
+     *
+     * \param folderName is the folder that should be removed from the zip file.
+     *
+     * \return true if the folder is collected, otherwise false (folderName is empty).
+     */
+    bool deleteFolder(const std::string& folderName);
+
+    /*!
+     * \brief Checks if the transaction contains any change.
+     *
+     * \return true if there is no change, otherwise false.
+     */
+    bool isEmpty();
+
+    /*!
+     * \brief Removes all collected changes.
+     */
+    void clear();
+
+private:
+    friend class Zip;
+
+    ZipTransaction(const ZipTransaction&);
+    ZipTransaction& operator=(const ZipTransaction&);
+
+private:
+    ZipTransactionPrivate* p;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_ZIPTRANSACTION_H_ */
@@ -0,0 +1,290 @@
+/*
+ * FileInfoIndexTest.cpp
+ *
+ *  Created on: 18.10.2026
+ */
+
+#include "FileInfoIndexTest.h"
+#include <FileInfoIndex.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <list>
+#include <string>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+namespace cppzip {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FileInfoIndexTest);
+
+namespace {
+
+std::string fileNameOf(size_t i)
+{
+    return "folder" + std::to_string(i % 7) + "/file" + std::to_string(i) + ".txt";
+}
+
+FileInfoRecord recordOf(size_t i)
+{
+    FileInfoRecord record;
+    record.numOfFile = i;
+    record.localHeaderOffset = i * 100;
+    record.uncompressedSize = i * 3;
+
+    return record;
+}
+
+ZipFileStamp stampOf(unsigned long long fileSize)
+{
+    ZipFileStamp stamp;
+    stamp.fileSize = fileSize;
+    stamp.modificationTime = 1512561600;
+    stamp.numEntries = 3;
+
+    return stamp;
+}
+
+} //anonymous namespace
+
+void FileInfoIndexTest::setUp(){
+    tempFolder = "temp";
+    indexFile = tempFolder + "/" + "test.idx";
+
+    boost::filesystem::remove_all(tempFolder);
+    boost::filesystem::create_directories(tempFolder);
+}
+
+void FileInfoIndexTest::tearDown(){
+    boost::filesystem::remove_all(tempFolder);
+}
+
+void FileInfoIndexTest::test_insert(){
+    FileInfoIndex index;
+
+    CPPUNIT_ASSERT_EQUAL(true, index.empty());
+    CPPUNIT_ASSERT_EQUAL(true, index.insert(fileNameOf(1), recordOf(1)));
+    CPPUNIT_ASSERT_EQUAL(true, index.insert(fileNameOf(2), recordOf(2)));
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), index.size());
+    CPPUNIT_ASSERT_EQUAL(true, index.contains(fileNameOf(1)));
+    CPPUNIT_ASSERT_EQUAL(2ull, index.find(fileNameOf(2))->numOfFile);
+    CPPUNIT_ASSERT(index.find(fileNameOf(3)) == NULL);
+}
+
+void FileInfoIndexTest::test_insert_WhenFileNameAlreadyExists(){
+    FileInfoIndex index;
+    index.insert(fileNameOf(1), recordOf(1));
+
+    //the existing record is kept
+    CPPUNIT_ASSERT_EQUAL(false, index.insert(fileNameOf(1), recordOf(2)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), index.size());
+    CPPUNIT_ASSERT_EQUAL(1ull, index.find(fileNameOf(1))->numOfFile);
+}
+
+void FileInfoIndexTest::test_insert_BeyondTheLoadFactor(){
+    FileInfoIndex index;
+    const size_t numFiles = 10000;
+
+    //the hash table is rehashed many times on the way
+    for(size_t i = 0; i < numFiles; ++i){
+        CPPUNIT_ASSERT_EQUAL(true, index.insert(fileNameOf(i), recordOf(i)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(numFiles, index.size());
+
+    for(size_t i = 0; i < numFiles; ++i){
+        const FileInfoRecord* record = index.find(fileNameOf(i));
+        CPPUNIT_ASSERT(record != NULL);
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(i), record->numOfFile);
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(i * 100), record->localHeaderOffset);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(false, index.contains(fileNameOf(numFiles)));
+
+    //the order of insertion is kept
+    size_t i = 0;
+    bool inOrder = true;
+    index.forEach([&](const std::string& fileName, const FileInfoRecord& record){
+        inOrder = inOrder && fileName == fileNameOf(i) && record.numOfFile == i;
+        ++i;
+    });
+
+    CPPUNIT_ASSERT_EQUAL(numFiles, i);
+    CPPUNIT_ASSERT_EQUAL(true, inOrder);
+}
+
+void FileInfoIndexTest::test_erase(){
+    FileInfoIndex index;
+    for(size_t i = 0; i < 100; ++i){
+        index.insert(fileNameOf(i), recordOf(i));
+    }
+
+    for(size_t i = 0; i < 100; i += 2){
+        CPPUNIT_ASSERT_EQUAL(true, index.erase(fileNameOf(i)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), index.size());
+
+    //the erased records don't hide the records probed behind them
+    for(size_t i = 0; i < 100; ++i){
+        CPPUNIT_ASSERT_EQUAL(i % 2 == 1, index.contains(fileNameOf(i)));
+    }
+
+    std::list<std::string> fileNames;
+    index.forEach([&](const std::string& fileName, const FileInfoRecord&){
+        fileNames.push_back(fileName);
+    });
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(50), fileNames.size());
+    CPPUNIT_ASSERT_EQUAL(fileNameOf(1), fileNames.front());
+    CPPUNIT_ASSERT_EQUAL(fileNameOf(99), fileNames.back());
+}
+
+void FileInfoIndexTest::test_erase_WhenFileNameNotExists(){
+    FileInfoIndex index;
+    CPPUNIT_ASSERT_EQUAL(false, index.erase(fileNameOf(1)));
+
+    index.insert(fileNameOf(1), recordOf(1));
+    CPPUNIT_ASSERT_EQUAL(true, index.erase(fileNameOf(1)));
+    CPPUNIT_ASSERT_EQUAL(false, index.erase(fileNameOf(1)));
+    CPPUNIT_ASSERT_EQUAL(true, index.empty());
+}
+
+void FileInfoIndexTest::test_insert_AfterErase(){
+    FileInfoIndex index;
+    index.insert(fileNameOf(1), recordOf(1));
+    index.insert(fileNameOf(2), recordOf(2));
+    index.erase(fileNameOf(1));
+
+    //the new record is found, not the erased one
+    CPPUNIT_ASSERT_EQUAL(true, index.insert(fileNameOf(1), recordOf(3)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), index.size());
+    CPPUNIT_ASSERT_EQUAL(3ull, index.find(fileNameOf(1))->numOfFile);
+    CPPUNIT_ASSERT_EQUAL(2ull, index.find(fileNameOf(2))->numOfFile);
+    CPPUNIT_ASSERT_EQUAL(false, index.insert(fileNameOf(1), recordOf(4)));
+
+    size_t numVisited = 0;
+    index.forEach([&](const std::string&, const FileInfoRecord&){ ++numVisited; });
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), numVisited);
+}
+
+void FileInfoIndexTest::test_insert_AfterManyErases(){
+    FileInfoIndex index;
+    const size_t numFiles = 50;
+
+    //the slots of the erased records fill the hash table, until it is rehashed
+    for(size_t round = 0; round < 200; ++round){
+        for(size_t i = 0; i < numFiles; ++i){
+            CPPUNIT_ASSERT_EQUAL(true, index.insert(fileNameOf(i), recordOf(round)));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(numFiles, index.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(round), index.find(fileNameOf(numFiles / 2))->numOfFile);
+
+        for(size_t i = 0; i < numFiles; ++i){
+            CPPUNIT_ASSERT_EQUAL(true, index.erase(fileNameOf(i)));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(true, index.empty());
+    }
+
+    CPPUNIT_ASSERT_EQUAL(false, index.contains(fileNameOf(0)));
+}
+
+void FileInfoIndexTest::test_saveAndLoad(){
+    FileInfoIndex index;
+    for(size_t i = 0; i < 1000; ++i){
+        index.insert(fileNameOf(i), recordOf(i));
+    }
+    index.erase(fileNameOf(10));
+
+    CPPUNIT_ASSERT_EQUAL(true, index.save(indexFile, stampOf(1234)));
+
+    FileInfoIndex loaded;
+    CPPUNIT_ASSERT_EQUAL(true, loaded.load(indexFile, stampOf(1234)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(999), loaded.size());
+    CPPUNIT_ASSERT_EQUAL(false, loaded.contains(fileNameOf(10)));
+
+    for(size_t i = 0; i < 1000; ++i){
+        if(i != 10){
+            CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(i * 3), loaded.find(fileNameOf(i))->uncompressedSize);
+        }
+    }
+}
+
+void FileInfoIndexTest::test_load_WithAnotherStamp(){
+    FileInfoIndex index;
+    index.insert(fileNameOf(1), recordOf(1));
+    CPPUNIT_ASSERT_EQUAL(true, index.save(indexFile, stampOf(1234)));
+
+    //the index is unchanged, if the index file belongs to another zip
+    FileInfoIndex loaded;
+    loaded.insert(fileNameOf(2), recordOf(2));
+    CPPUNIT_ASSERT_EQUAL(false, loaded.load(indexFile, stampOf(1235)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), loaded.size());
+    CPPUNIT_ASSERT_EQUAL(true, loaded.contains(fileNameOf(2)));
+    CPPUNIT_ASSERT_EQUAL(false, loaded.contains(fileNameOf(1)));
+
+    CPPUNIT_ASSERT_EQUAL(false, loaded.load(tempFolder + "/not_existing.idx", stampOf(1234)));
+}
+
+void FileInfoIndexTest::test_eraseAndInsert_AfterLoad(){
+    FileInfoIndex index;
+    for(size_t i = 0; i < 100; ++i){
+        index.insert(fileNameOf(i), recordOf(i));
+    }
+    CPPUNIT_ASSERT_EQUAL(true, index.save(indexFile, stampOf(1234)));
+
+    //the loaded index file is copied before the index is changed
+    FileInfoIndex loaded;
+    CPPUNIT_ASSERT_EQUAL(true, loaded.load(indexFile, stampOf(1234)));
+    CPPUNIT_ASSERT_EQUAL(true, loaded.erase(fileNameOf(5)));
+    CPPUNIT_ASSERT_EQUAL(true, loaded.insert(fileNameOf(5), recordOf(500)));
+
+    for(size_t i = 100; i < 1000; ++i){
+        CPPUNIT_ASSERT_EQUAL(true, loaded.insert(fileNameOf(i), recordOf(i)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1000), loaded.size());
+    CPPUNIT_ASSERT_EQUAL(500ull, loaded.find(fileNameOf(5))->numOfFile);
+    CPPUNIT_ASSERT_EQUAL(50ull, loaded.find(fileNameOf(50))->numOfFile);
+    CPPUNIT_ASSERT_EQUAL(999ull, loaded.find(fileNameOf(999))->numOfFile);
+
+    //the index file itself is unchanged
+    FileInfoIndex reloaded;
+    CPPUNIT_ASSERT_EQUAL(true, reloaded.load(indexFile, stampOf(1234)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(100), reloaded.size());
+    CPPUNIT_ASSERT_EQUAL(5ull, reloaded.find(fileNameOf(5))->numOfFile);
+}
+
+void FileInfoIndexTest::test_eraseAndInsert_WithAFullIndexFile(){
+    FileInfoIndex index;
+    index.insert(fileNameOf(1), recordOf(1));
+    CPPUNIT_ASSERT_EQUAL(true, index.save(indexFile, stampOf(1234)));
+
+    //a broken index file: all 16 slots point to the one entry, the slots are followed by the name
+    const size_t numSlots = 16;
+    std::vector<unsigned int> slots(numSlots, 1);
+    std::streamoff slotsOffset = static_cast<std::streamoff>(boost::filesystem::file_size(indexFile) -
+                                                             fileNameOf(1).size() -
+                                                             numSlots * sizeof(unsigned int));
+    {
+        boost::filesystem::fstream fs(indexFile, std::ios::in | std::ios::out | std::ios::binary);
+        fs.seekp(slotsOffset);
+        fs.write(reinterpret_cast<const char*>(slots.data()),
+                 static_cast<std::streamsize>(numSlots * sizeof(unsigned int)));
+    }
+
+    FileInfoIndex loaded;
+    CPPUNIT_ASSERT_EQUAL(true, loaded.load(indexFile, stampOf(1234)));
+    CPPUNIT_ASSERT_EQUAL(true, loaded.contains(fileNameOf(1)));
+
+    //there is no free slot, the search ends after all slots
+    CPPUNIT_ASSERT_EQUAL(false, loaded.insert(fileNameOf(2), recordOf(2)));
+    CPPUNIT_ASSERT_EQUAL(false, loaded.erase(fileNameOf(2)));
+    CPPUNIT_ASSERT_EQUAL(true, loaded.erase(fileNameOf(1)));
+    CPPUNIT_ASSERT_EQUAL(false, loaded.contains(fileNameOf(1)));
+}
+
+} //cppzip
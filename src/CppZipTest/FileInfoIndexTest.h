@@ -0,0 +1,87 @@
+/*!
+ * FileInfoIndexTest.h -- Tests FileInfoIndex.h from CppZip
+ * Version 1.0.1.4, 06.12.2017
+ * part of the CppZip project - (https://github.com/flo2k/CppZip)
+ *
+ * Created: 18.10.2026
+ *
+ * Copyright (C) 2014-2017 Florian Künzner (CppZip) (https://github.com/flo2k/CppZip)
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * Condition of use and distribution are the same than minizip and zlib :
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ */
+
+#ifndef CPPZIP_FILEINFOINDEXTEST_H_
+#define CPPZIP_FILEINFOINDEXTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+namespace cppzip {
+
+class FileInfoIndexTest : public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(FileInfoIndexTest);
+        CPPUNIT_TEST(test_insert);
+        CPPUNIT_TEST(test_insert_WhenFileNameAlreadyExists);
+        CPPUNIT_TEST(test_insert_BeyondTheLoadFactor);
+
+        CPPUNIT_TEST(test_erase);
+        CPPUNIT_TEST(test_erase_WhenFileNameNotExists);
+        CPPUNIT_TEST(test_insert_AfterErase);
+        CPPUNIT_TEST(test_insert_AfterManyErases);
+
+        CPPUNIT_TEST(test_saveAndLoad);
+        CPPUNIT_TEST(test_load_WithAnotherStamp);
+        CPPUNIT_TEST(test_eraseAndInsert_AfterLoad);
+        CPPUNIT_TEST(test_eraseAndInsert_WithAFullIndexFile);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+public:
+    void test_insert();
+    void test_insert_WhenFileNameAlreadyExists();
+    void test_insert_BeyondTheLoadFactor();
+
+    void test_erase();
+    void test_erase_WhenFileNameNotExists();
+    void test_insert_AfterErase();
+    void test_insert_AfterManyErases();
+
+    void test_saveAndLoad();
+    void test_load_WithAnotherStamp();
+    void test_eraseAndInsert_AfterLoad();
+    void test_eraseAndInsert_WithAFullIndexFile();
+
+private:
+    std::string tempFolder;
+    std::string indexFile;
+};
+
+} //cppzip
+
+#endif /* CPPZIP_FILEINFOINDEXTEST_H_ */
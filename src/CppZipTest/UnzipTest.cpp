@@ -7,13 +7,19 @@
 
 #include "UnzipTest.h"
 #include <Unzip.h>
+#include <UnzipFileReader.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <list>
 #include <string>
 #include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <set>
+#include <thread>
 #include <boost/foreach.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
 #include <boost/bind.hpp>
 #include <boost/lambda/lambda.hpp>
 
@@ -26,6 +32,11 @@ void UnzipTest::setUp(){
     zipFile = testZipsFolder + "/" + "test.zip";
     zipFileWithUmlaut = testZipsFolder + "/" + "täst.zip";
     anotherZipFile = testZipsFolder + "/" + "another_test.zip";
+    zipFileWithUnorderedCentralDirectory = testZipsFolder + "/" + "unordered_central_directory.zip";
+    zipFileWithStoredFiles = testZipsFolder + "/" + "stored_files.zip";
+    zipFileWithWrongSizes = testZipsFolder + "/" + "wrong_size.zip";
+    zipFileWithMultipleFiles = testZipsFolder + "/" + "multi_files.zip";
+    zipFileWithACorruptFile = testZipsFolder + "/" + "corrupt_entry.zip";
     notExistingZipFile = testZipsFolder + "/" + "not_existing_file.zip";
     passwordProtectedZipFile_linux32bit = testZipsFolder + "/" + "passwordProtected_linux_32bit.zip";
     passwordProtectedZipFile_linux64bit = testZipsFolder + "/" + "passwordProtected_linux_64bit.zip";
@@ -87,6 +98,49 @@ void UnzipTest::test_openANonExistingZipFile()
     CPPUNIT_ASSERT_EQUAL(expected, actual);
 }
 
+void UnzipTest::test_openExistingZipFile_MemoryMapped()
+{
+    bool openOk = zip->open(zipFile, "", ReadModes::MemoryMapped);
+
+    CPPUNIT_ASSERT_EQUAL(true, openOk);
+    CPPUNIT_ASSERT_EQUAL(true, zip->isOpened());
+    CPPUNIT_ASSERT_EQUAL(true, zip->containsFile(fileInsideZip));
+}
+
+void UnzipTest::test_openANonExistingZipFile_MemoryMapped()
+{
+    bool actual = zip->open(notExistingZipFile, "", ReadModes::MemoryMapped);
+
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+    CPPUNIT_ASSERT_EQUAL(false, zip->isOpened());
+}
+
+void UnzipTest::test_openZipInMemory()
+{
+    boost::filesystem::ifstream ifs(zipFile, std::ios::in | std::ios::binary);
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(ifs)),
+                                    std::istreambuf_iterator<char>());
+
+    bool openOk = zip->open(data.data(), data.size());
+    CPPUNIT_ASSERT_EQUAL(true, openOk);
+
+    std::vector<unsigned char> content = zip->getFileContent(picsFolder + "/" + fileInsideZipJpg);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), content.size());
+
+    bool actual = zip->extractAllFilesTo(tempFolder);
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+}
+
+void UnzipTest::test_openZipInMemory_WithInvalidData()
+{
+    std::vector<unsigned char> data(1000, 'a');
+
+    bool actual = zip->open(data.data(), data.size());
+
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+    CPPUNIT_ASSERT_EQUAL(false, zip->isOpened());
+}
+
 void UnzipTest::test_closeAZipFile()
 {
     bool expected = true;
@@ -214,6 +268,27 @@ void UnzipTest::test_getFileNamesWithNoZipFileIsOpened()
     CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
 }
 
+void UnzipTest::test_getFileNamesInZipOrder()
+{
+    //the central directory lists the files in another order than their data
+    std::list<std::string> expectedFileNames;
+    expectedFileNames.push_back("folder/second.txt");
+    expectedFileNames.push_back("first.txt");
+    expectedFileNames.push_back("third.txt");
+    expectedFileNames.push_back("folder/");
+
+    std::list<std::string> expectedFileNamesInZipOrder;
+    expectedFileNamesInZipOrder.push_back("first.txt");
+    expectedFileNamesInZipOrder.push_back("folder/");
+    expectedFileNamesInZipOrder.push_back("folder/second.txt");
+    expectedFileNamesInZipOrder.push_back("third.txt");
+
+    zip->open(zipFileWithUnorderedCentralDirectory);
+
+    CPPUNIT_ASSERT(expectedFileNames == zip->getFileNames());
+    CPPUNIT_ASSERT(expectedFileNamesInZipOrder == zip->getFileNamesInZipOrder());
+}
+
 void UnzipTest::test_getFileNamesAfterCloseZipFiled()
 {
     std::vector<std::string> expected;
@@ -264,6 +339,444 @@ void UnzipTest::test_getFileContentFromANonExistingFile()
     CPPUNIT_ASSERT_EQUAL(expected, actual);
 }
 
+void UnzipTest::test_getFileContent_AJpg()
+{
+    zip->open(zipFile);
+    std::vector<unsigned char> content = zip->getFileContent(picsFolder + "/" + fileInsideZipJpg);
+
+    size_t expectedFileSizeInBytes = 220635;
+    CPPUNIT_ASSERT_EQUAL(expectedFileSizeInBytes, content.size());
+
+    //the content is the same as the extracted file
+    std::string fileName = tempFolder + "/" + fileInsideZipJpg;
+    zip->extractFileTo(picsFolder + "/" + fileInsideZipJpg, fileName);
+
+    boost::filesystem::ifstream ifs(fileName, std::ios::in | std::ios::binary);
+    std::vector<unsigned char> extracted((std::istreambuf_iterator<char>(ifs)),
+                                         std::istreambuf_iterator<char>());
+    CPPUNIT_ASSERT(content == extracted);
+}
+
+void UnzipTest::test_getFileContentIntoBuffer()
+{
+    zip->open(zipFile);
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    std::vector<unsigned char> buffer(zip->getFileSize(fileName) + 10);
+    size_t contentSize = 0;
+    bool actual = zip->getFileContent(fileName, buffer.data(), buffer.size(), contentSize);
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), contentSize);
+
+    std::vector<unsigned char> expected = zip->getFileContent(fileName);
+    CPPUNIT_ASSERT(std::equal(expected.begin(), expected.end(), buffer.begin()));
+}
+
+void UnzipTest::test_getFileContentIntoBuffer_WithTooSmallBuffer()
+{
+    zip->open(zipFile);
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    std::vector<unsigned char> buffer(1000);
+    size_t contentSize = 0;
+    bool actual = zip->getFileContent(fileName, buffer.data(), buffer.size(), contentSize);
+
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+}
+
+void UnzipTest::test_getFileContent_WithWrongSizeInCentralDirectory()
+{
+    //the encrypted files are read by minizip, the others by EntryReader, both reject them
+    std::list<std::string> fileNames;
+    fileNames.push_back("too_small.txt");
+    fileNames.push_back("too_big.txt");
+    fileNames.push_back("encrypted_too_small.txt");
+    fileNames.push_back("encrypted_too_big.txt");
+
+    zip->open(zipFileWithWrongSizes, "secret");
+
+    BOOST_FOREACH(const std::string& fileName, fileNames){
+        std::vector<unsigned char> buffer(4096);
+        size_t contentSize = 0;
+
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, static_cast<size_t>(0), zip->getFileContent(fileName).size());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, false, zip->getFileContent(fileName, buffer.data(), buffer.size(), contentSize));
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, static_cast<size_t>(0), contentSize);
+    }
+}
+
+void UnzipTest::test_getFileSize()
+{
+    zip->open(zipFile);
+
+    CPPUNIT_ASSERT_EQUAL(220635ull, zip->getFileSize(picsFolder + "/" + fileInsideZipJpg));
+    CPPUNIT_ASSERT_EQUAL(2ull, zip->getFileSize(fileInsideZip));
+    CPPUNIT_ASSERT_EQUAL(0ull, zip->getFileSize(fileInsideZipThatDoesNotExist));
+}
+
+void UnzipTest::test_openFileReader()
+{
+    zip->open(zipFile);
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    std::shared_ptr<UnzipFileReader> reader = zip->openFileReader(fileName);
+    CPPUNIT_ASSERT(reader);
+    CPPUNIT_ASSERT_EQUAL(fileName, reader->getFileName());
+    CPPUNIT_ASSERT_EQUAL(220635ull, reader->getFileSize());
+
+    std::vector<unsigned char> content;
+    unsigned char buffer[4096];
+    long long len = 0;
+    while((len = reader->read(buffer, sizeof(buffer))) > 0){
+        content.insert(content.end(), buffer, buffer + len);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0ll, len);
+    CPPUNIT_ASSERT_EQUAL(true, reader->isEndOfFile());
+    CPPUNIT_ASSERT_EQUAL(220635ull, reader->getBytesRead());
+    CPPUNIT_ASSERT_EQUAL(true, reader->close());
+    CPPUNIT_ASSERT(content == zip->getFileContent(fileName));
+}
+
+void UnzipTest::test_openFileReader_WithANonExistingFile()
+{
+    zip->open(zipFile);
+
+    CPPUNIT_ASSERT(! zip->openFileReader(fileInsideZipThatDoesNotExist));
+    CPPUNIT_ASSERT(! zip->openFileReader(picsFolder + "/"));
+}
+
+void UnzipTest::test_openFileReader_WhileReadingOtherFiles()
+{
+    zip->open(zipFile);
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    std::shared_ptr<UnzipFileReader> reader = zip->openFileReader(fileName);
+    CPPUNIT_ASSERT(reader);
+
+    unsigned char buffer[1000];
+    CPPUNIT_ASSERT_EQUAL(1000ll, reader->read(buffer, sizeof(buffer)));
+
+    //the reader has its own handle, the zip can be used meanwhile
+    std::vector<unsigned char> content = zip->getFileContent(fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), content.size());
+
+    unsigned long long total = 1000;
+    long long len = 0;
+    while((len = reader->read(buffer, sizeof(buffer))) > 0){
+        total += len;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(220635ull, total);
+    CPPUNIT_ASSERT_EQUAL(true, reader->close());
+}
+
+void UnzipTest::test_getFileContent_WithMultipleThreads()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expectedJpg = zip->getFileContent(fileName);
+    std::vector<unsigned char> expectedTxt = zip->getFileContent(fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), expectedJpg.size());
+
+    //all threads read from the same Unzip
+    std::atomic<int> numWrongContents(0);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i){
+        threads.push_back(std::thread([&](){
+            for(int j = 0; j < 20; ++j){
+                if(zip->getFileContent(fileName) != expectedJpg ||
+                   zip->getFileContent(fileInsideZip) != expectedTxt){
+                    ++numWrongContents;
+                }
+            }
+        }));
+    }
+
+    for(auto& thread : threads){
+        thread.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, numWrongContents.load());
+}
+
+void UnzipTest::test_extractAllFilesTo_InZipOrder()
+{
+    std::list<std::string> expectedFileNames;
+    expectedFileNames.push_back(tempFolder + "/first.txt");
+    expectedFileNames.push_back(tempFolder + "/folder/second.txt");
+    expectedFileNames.push_back(tempFolder + "/third.txt");
+
+    std::list<std::string> actualFileNames;
+
+    zip->open(zipFileWithUnorderedCentralDirectory);
+    zip->beforeFileExtraction.connect([&](std::string& fileName){
+        actualFileNames.push_back(fileName);
+    });
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->extractAllFilesTo(tempFolder));
+    CPPUNIT_ASSERT(expectedFileNames == actualFileNames);
+}
+
+void UnzipTest::test_getFileContent_WithSeveralUnzips()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expectedJpg = zip->getFileContent(fileName);
+    std::vector<unsigned char> expectedTxt = zip->getFileContent(fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), expectedJpg.size());
+
+    //the Unzips share the pooled inflate states, one after the other
+    Unzip otherZip;
+    CPPUNIT_ASSERT(otherZip.open(zipFile, "", ReadModes::MemoryMapped));
+
+    for(int i = 0; i < 10; ++i){
+        CPPUNIT_ASSERT(otherZip.getFileContent(fileName) == expectedJpg);
+        CPPUNIT_ASSERT(zip->getFileContent(fileInsideZip) == expectedTxt);
+        CPPUNIT_ASSERT(otherZip.getFileContent(fileInsideZip) == expectedTxt);
+        CPPUNIT_ASSERT(zip->getFileContent(fileName) == expectedJpg);
+    }
+}
+
+void UnzipTest::test_getFileContent_AfterACorruptFile()
+{
+    //the deflate stream of corrupt.txt has an invalid block in the middle
+    zip->open(zipFileWithACorruptFile);
+    CPPUNIT_ASSERT_EQUAL(18450ull, zip->getFileSize("first.txt"));
+    CPPUNIT_ASSERT_EQUAL(18413ull, zip->getFileSize("second.txt"));
+
+    //the inflate state of the failed file is reset and reused for the next files
+    for(int i = 0; i < 10; ++i){
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(18450), zip->getFileContent("first.txt").size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), zip->getFileContent("corrupt.txt").size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(18413), zip->getFileContent("second.txt").size());
+    }
+
+    std::vector<unsigned char> buffer(20000);
+    size_t contentSize = 0;
+    CPPUNIT_ASSERT_EQUAL(false, zip->getFileContent("corrupt.txt", buffer.data(), buffer.size(), contentSize));
+    CPPUNIT_ASSERT_EQUAL(true, zip->getFileContent("first.txt", buffer.data(), buffer.size(), contentSize));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(18450), contentSize);
+
+    //extracting checks the crc-32 of the files
+    CPPUNIT_ASSERT_EQUAL(false, zip->extractFileTo("corrupt.txt", tempFolder + "/corrupt.txt"));
+    CPPUNIT_ASSERT_EQUAL(true, zip->extractFileTo("second.txt", tempFolder + "/second.txt"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<boost::uintmax_t>(18413), boost::filesystem::file_size(tempFolder + "/second.txt"));
+}
+
+void UnzipTest::test_readFileContentAt()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expected = zip->getFileContent(fileName);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), expected.size());
+
+    //small span: the reads start at several checkpoints
+    CPPUNIT_ASSERT_EQUAL(true, zip->buildCheckpointIndex(fileName, 16384));
+
+    std::vector<unsigned char> buffer(5000);
+    for(size_t offset = 0; offset < expected.size(); offset += 12345){
+        size_t contentSize = 0;
+        CPPUNIT_ASSERT_EQUAL(true, zip->readFileContentAt(fileName, offset, buffer.data(), buffer.size(), contentSize));
+
+        size_t expectedSize = std::min(buffer.size(), expected.size() - offset);
+        CPPUNIT_ASSERT_EQUAL(expectedSize, contentSize);
+        CPPUNIT_ASSERT(std::equal(buffer.begin(), buffer.begin() + contentSize, expected.begin() + offset));
+    }
+
+    //behind the end nothing is read
+    size_t contentSize = 1;
+    CPPUNIT_ASSERT_EQUAL(true, zip->readFileContentAt(fileName, expected.size(), buffer.data(), buffer.size(), contentSize));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), contentSize);
+
+    CPPUNIT_ASSERT_EQUAL(false, zip->readFileContentAt("not_existing.txt", 0, buffer.data(), buffer.size(), contentSize));
+}
+
+void UnzipTest::test_getFileContent_WithOffset()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expected = zip->getFileContent(fileName);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), expected.size());
+
+    //the head
+    std::vector<unsigned char> head = zip->getFileContent(fileName, 0, 100);
+    CPPUNIT_ASSERT(std::vector<unsigned char>(expected.begin(), expected.begin() + 100) == head);
+
+    //the tail, longer than the rest of the file
+    std::vector<unsigned char> tail = zip->getFileContent(fileName, 220000, 1000);
+    CPPUNIT_ASSERT(std::vector<unsigned char>(expected.begin() + 220000, expected.end()) == tail);
+
+    //behind the end
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), zip->getFileContent(fileName, 220635, 1000).size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), zip->getFileContent("not_existing.txt", 0, 1000).size());
+
+    //the same with a checkpoint index
+    CPPUNIT_ASSERT_EQUAL(true, zip->buildCheckpointIndex(fileName, 16384));
+    std::vector<unsigned char> middle = zip->getFileContent(fileName, 123456, 5000);
+    CPPUNIT_ASSERT(std::vector<unsigned char>(expected.begin() + 123456, expected.begin() + 128456) == middle);
+}
+
+void UnzipTest::test_getFileContent_WithOffset_FromPasswordProtectedZipFile()
+{
+    bool ok = zip->open(passwordProtectedZipFile_linux64bit, "secret");
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("open", true, ok);
+    std::vector<unsigned char> content = zip->getFileContent(fileInsideZip, 5, 6);
+
+    std::string expected = "is a s";
+    std::string actual(content.begin(), content.end());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", expected, actual);
+}
+
+void UnzipTest::test_saveAndLoadCheckpointIndex()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+    std::string checkpointFileName = tempFolder + "/matrix.jpg.checkpoints";
+    boost::filesystem::create_directories(tempFolder);
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expected = zip->getFileContent(fileName);
+
+    CPPUNIT_ASSERT_EQUAL(false, zip->saveCheckpointIndex(fileName, checkpointFileName));
+    CPPUNIT_ASSERT_EQUAL(true, zip->buildCheckpointIndex(fileName, 16384));
+    CPPUNIT_ASSERT_EQUAL(true, zip->saveCheckpointIndex(fileName, checkpointFileName));
+    zip->close();
+
+    zip->open(zipFile);
+    CPPUNIT_ASSERT_EQUAL(false, zip->loadCheckpointIndex(fileInsideZip, checkpointFileName));
+    CPPUNIT_ASSERT_EQUAL(true, zip->loadCheckpointIndex(fileName, checkpointFileName));
+
+    std::vector<unsigned char> buffer(1000);
+    size_t contentSize = 0;
+    CPPUNIT_ASSERT_EQUAL(true, zip->readFileContentAt(fileName, 200000, buffer.data(), buffer.size(), contentSize));
+    CPPUNIT_ASSERT_EQUAL(buffer.size(), contentSize);
+    CPPUNIT_ASSERT(std::equal(buffer.begin(), buffer.end(), expected.begin() + 200000));
+}
+
+void UnzipTest::test_getStoredFileRange()
+{
+    std::string storedFile = "folder/stored.txt";
+    std::string zipFileName;
+    unsigned long long offset = 0;
+    unsigned long long length = 0;
+
+    zip->open(zipFileWithStoredFiles);
+    std::vector<unsigned char> expected = zip->getFileContent(storedFile);
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->getStoredFileRange(storedFile, zipFileName, offset, length));
+    CPPUNIT_ASSERT_EQUAL(zipFileWithStoredFiles, zipFileName);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(expected.size()), length);
+
+    //the content is one piece of the zip file
+    std::vector<unsigned char> actual(static_cast<size_t>(length));
+    boost::filesystem::ifstream ifs(zipFileName, std::ios::in | std::ios::binary);
+    ifs.seekg(static_cast<std::streamoff>(offset));
+    ifs.read(reinterpret_cast<char*>(actual.data()), actual.size());
+    CPPUNIT_ASSERT(expected == actual);
+
+    //compressed files and folders are not one piece
+    CPPUNIT_ASSERT_EQUAL(false, zip->getStoredFileRange("deflated.txt", zipFileName, offset, length));
+    CPPUNIT_ASSERT_EQUAL(false, zip->getStoredFileRange("folder/", zipFileName, offset, length));
+    CPPUNIT_ASSERT_EQUAL(false, zip->getStoredFileRange("not_existing.txt", zipFileName, offset, length));
+}
+
+void UnzipTest::test_getRawFileContent()
+{
+    std::vector<unsigned char> rawContent;
+    int method = -1;
+    unsigned long crc = 0;
+    unsigned long long uncompressedSize = 0;
+
+    zip->open(zipFileWithStoredFiles);
+
+    //a stored file is the same raw as uncompressed
+    std::vector<unsigned char> expected = zip->getFileContent("folder/stored.txt");
+    CPPUNIT_ASSERT_EQUAL(true, zip->getRawFileContent("folder/stored.txt", rawContent, method, crc, uncompressedSize));
+    CPPUNIT_ASSERT_EQUAL(0, method);
+    CPPUNIT_ASSERT_EQUAL(4104963255UL, crc);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(expected.size()), uncompressedSize);
+    CPPUNIT_ASSERT(expected == rawContent);
+
+    //a deflated file isn't uncompressed
+    CPPUNIT_ASSERT_EQUAL(true, zip->getRawFileContent("deflated.txt", rawContent, method, crc, uncompressedSize));
+    CPPUNIT_ASSERT_EQUAL(8, method);
+    CPPUNIT_ASSERT_EQUAL(701232148UL, crc);
+    CPPUNIT_ASSERT_EQUAL(220ULL, uncompressedSize);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(26), rawContent.size());
+
+    CPPUNIT_ASSERT_EQUAL(false, zip->getRawFileContent("folder/", rawContent, method, crc, uncompressedSize));
+    CPPUNIT_ASSERT_EQUAL(false, zip->getRawFileContent("not_existing.txt", rawContent, method, crc, uncompressedSize));
+    CPPUNIT_ASSERT(rawContent.empty());
+}
+
+void UnzipTest::test_getRawFileContent_FromPasswordProtectedZipFile()
+{
+    std::vector<unsigned char> rawContent;
+    int method = -1;
+    unsigned long crc = 0;
+    unsigned long long uncompressedSize = 0;
+
+    zip->open(passwordProtectedZipFile_linux64bit, "secret");
+
+    CPPUNIT_ASSERT_EQUAL(false, zip->getRawFileContent(fileInsideZip, rawContent, method, crc, uncompressedSize));
+    CPPUNIT_ASSERT(rawContent.empty());
+}
+
+void UnzipTest::test_getFileContent_MemoryMapped()
+{
+    std::string fileName = picsFolder + "/" + fileInsideZipJpg;
+
+    zip->open(zipFile);
+    std::vector<unsigned char> expected = zip->getFileContent(fileName);
+    zip->close();
+
+    zip->open(zipFile, "", ReadModes::MemoryMapped);
+    std::vector<unsigned char> actual = zip->getFileContent(fileName);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(220635), actual.size());
+    CPPUNIT_ASSERT(expected == actual);
+
+    //the reader keeps the mapping alive
+    std::shared_ptr<UnzipFileReader> reader = zip->openFileReader(fileName);
+    zip->close();
+
+    std::vector<unsigned char> buffer(actual.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<long long>(actual.size()), reader->read(buffer.data(), buffer.size()));
+    CPPUNIT_ASSERT(expected == buffer);
+}
+
+void UnzipTest::test_getFileContentFromPasswordProtectedZipFile_MemoryMapped()
+{
+    bool ok = zip->open(passwordProtectedZipFile_linux64bit, "secret", ReadModes::MemoryMapped);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("open", true, ok);
+    std::vector<unsigned char> content = zip->getFileContent(fileInsideZip);
+
+    std::string expected = "this is a string";
+    std::string actual(content.begin(), content.end());
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", expected, actual);
+}
+
+void UnzipTest::test_extractAllFilesTo_MemoryMapped_WithMultipleThreads()
+{
+    zip->open(zipFile, "", ReadModes::MemoryMapped);
+    zip->setNumberOfThreads(4);
+
+    bool actual = zip->extractAllFilesTo(tempFolder);
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+
+    size_t expectedFileSizeInBytes = 220635;
+    size_t actualFileSizeInBytes = boost::filesystem::file_size(
+            tempFolder + "/" + picsFolder + "/" + fileInsideZipJpg);
+    CPPUNIT_ASSERT_EQUAL(expectedFileSizeInBytes, actualFileSizeInBytes);
+}
+
 void UnzipTest::test_getFileContentFromPasswordProtectedZipFile_linux32bit()
 {
     bool ok = zip->open(passwordProtectedZipFile_linux32bit, "secret");
@@ -437,6 +950,116 @@ void UnzipTest::test_extractAllFiles_WithNotOverwriteAExistingFile()
     CPPUNIT_ASSERT_EQUAL_MESSAGE("extract and overwrite existing", false, actual);
 }
 
+void UnzipTest::test_extractAllFilesTo_WithMultipleThreads()
+{
+    zip->open(zipFile);
+    zip->setNumberOfThreads(4);
+
+    bool actual = zip->extractAllFilesTo(tempFolder);
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+
+    std::list<std::string> fileNames = zip->getFileNames();
+    for(const auto& fileName : fileNames){
+        boost::filesystem::path path(tempFolder + "/" + fileName);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName, true, boost::filesystem::exists(path));
+
+        if(boost::filesystem::is_regular_file(path)){
+            std::vector<unsigned char> content = zip->getFileContent(fileName);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(fileName,
+                    static_cast<uintmax_t>(content.size()),
+                    boost::filesystem::file_size(path));
+        }
+    }
+}
+
+void UnzipTest::test_setNumberOfThreads()
+{
+    CPPUNIT_ASSERT_EQUAL(1u, zip->getNumberOfThreads());
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->setNumberOfThreads(4));
+    CPPUNIT_ASSERT_EQUAL(4u, zip->getNumberOfThreads());
+
+    CPPUNIT_ASSERT_EQUAL(false, zip->setNumberOfThreads(0));
+    CPPUNIT_ASSERT_EQUAL(4u, zip->getNumberOfThreads());
+}
+
+void UnzipTest::test_setIndexMode()
+{
+    CPPUNIT_ASSERT_EQUAL(IndexModes::Eager, zip->getIndexMode());
+
+    zip->setIndexMode(IndexModes::Lazy);
+    CPPUNIT_ASSERT_EQUAL(IndexModes::Lazy, zip->getIndexMode());
+}
+
+void UnzipTest::test_open_WithLazyIndexMode()
+{
+    zip->setIndexMode(IndexModes::Lazy);
+
+    bool actual = zip->open(zipFile);
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL(6, zip->getNumFiles());
+
+    //the file infos are read with the first lookup
+    std::vector<unsigned char> content = zip->getFileContent(fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), content.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), zip->getFileNames().size());
+
+    //and again after reopening
+    zip->close();
+    zip->open(zipFile);
+    CPPUNIT_ASSERT_EQUAL(true, zip->containsFile(fileInsideZip));
+}
+
+void UnzipTest::test_open_WithIndexFile()
+{
+    std::string tempZipFile = tempFolder + "/test.zip";
+    boost::filesystem::create_directories(tempFolder);
+    boost::filesystem::copy_file(zipFile, tempZipFile);
+
+    zip->setIndexMode(IndexModes::IndexFile);
+
+    //the first open writes the index file, the second one loads it
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(tempZipFile));
+    CPPUNIT_ASSERT_EQUAL(tempZipFile + ".idx", zip->getIndexFileName());
+    CPPUNIT_ASSERT_EQUAL(true, boost::filesystem::exists(tempZipFile + ".idx"));
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(tempZipFile));
+    CPPUNIT_ASSERT_EQUAL(6, zip->getNumFiles());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), zip->getFileNames().size());
+    CPPUNIT_ASSERT_EQUAL(false, zip->containsFile(fileInsideZipThatDoesNotExist));
+
+    std::vector<unsigned char> content = zip->getFileContent(fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), content.size());
+}
+
+void UnzipTest::test_open_WithIndexFile_WhenZipFileChanged()
+{
+    std::string tempZipFile = tempFolder + "/test.zip";
+    std::string indexFile = tempFolder + "/test.index";
+    boost::filesystem::create_directories(tempFolder);
+    boost::filesystem::copy_file(zipFile, tempZipFile);
+
+    zip->setIndexMode(IndexModes::IndexFile);
+    zip->setIndexFileName(indexFile);
+
+    zip->open(tempZipFile);
+    zip->close();
+    CPPUNIT_ASSERT_EQUAL(true, boost::filesystem::exists(indexFile));
+
+    //the index file doesn't belong to the new zip
+    boost::filesystem::copy_file(anotherZipFile, tempZipFile,
+                                 boost::filesystem::copy_option::overwrite_if_exists);
+
+    Unzip anotherZip;
+    anotherZip.open(anotherZipFile);
+    std::list<std::string> expected = anotherZip.getFileNames();
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(tempZipFile));
+    CPPUNIT_ASSERT(expected == zip->getFileNames());
+    CPPUNIT_ASSERT_EQUAL(false, zip->containsFile(fileInsideZip));
+}
+
 bool actualFileExtracted = false;
 std::string actualFileName = "";
 int actualMax = -1;
@@ -448,6 +1071,43 @@ void fileExtractedSignalHandler(const std::string fileName, unsigned int max, un
     actualCurrent = current;
 }
 
+void UnzipTest::test_openFileReader_WithIndexFile()
+{
+    std::string tempZipFile = tempFolder + "/multi_files.zip";
+    boost::filesystem::create_directories(tempFolder);
+    boost::filesystem::copy_file(zipFileWithMultipleFiles, tempZipFile);
+
+    zip->setIndexMode(IndexModes::IndexFile);
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(tempZipFile));
+    zip->close();
+
+    //the reader jumps to the central directory position of the loaded index file
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(tempZipFile));
+
+    std::string expected;
+    for(int i = 0; i < 16; ++i){
+        expected += "this is file 15\n";
+    }
+
+    CPPUNIT_ASSERT_EQUAL(expected, readWithFileReader("file_15.txt"));
+    CPPUNIT_ASSERT_EQUAL(std::string("this is file 00\n"), readWithFileReader("file_00.txt"));
+}
+
+void UnzipTest::test_openFileReader_WithLazyIndexMode()
+{
+    zip->setIndexMode(IndexModes::Lazy);
+    CPPUNIT_ASSERT_EQUAL(true, zip->open(zipFileWithMultipleFiles));
+
+    std::string expected;
+    for(int i = 0; i < 16; ++i){
+        expected += "this is file 15\n";
+    }
+
+    //the index is retrieved by the first access
+    CPPUNIT_ASSERT_EQUAL(expected, readWithFileReader("file_15.txt"));
+    CPPUNIT_ASSERT_EQUAL(std::string("this is file 00\n"), readWithFileReader("file_00.txt"));
+}
+
 void UnzipTest::test_signalFileExtracted()
 {
     actualFileExtracted = false;
@@ -480,6 +1140,23 @@ void UnzipTest::test_signalBeforeFileExtracted()
     CPPUNIT_ASSERT_EQUAL(tempFolder + "/" + fileInsideZip, actualFileName);
 }
 
+std::string UnzipTest::readWithFileReader(const std::string& fileName)
+{
+    std::shared_ptr<UnzipFileReader> reader = zip->openFileReader(fileName);
+    if(! reader){
+        return std::string();
+    }
+
+    std::string content;
+    char buffer[256];
+    long long len = 0;
+    while((len = reader->read(reinterpret_cast<unsigned char*>(buffer), sizeof(buffer))) > 0){
+        content.append(buffer, static_cast<size_t>(len));
+    }
+
+    return content;
+}
+
 void UnzipTest::beforeFileExtractedSignalHandler_ChangeFileName(std::string& fileName){
     fileName = tempFolder + "/" + anotherFileName;
 }
@@ -498,4 +1175,71 @@ void UnzipTest::test_signalBeforeFileExtractedWithChangingFileName()
     CPPUNIT_ASSERT_EQUAL(expected, actual);
 }
 
+std::set<int> actualCurrents;
+void fileExtractedWithCurrentsSignalHandler(const std::string fileName, unsigned int max, unsigned int current){
+    actualMax = max;
+    actualCurrents.insert(current);
+}
+
+void UnzipTest::test_signalFileExtracted_WithMultipleThreads()
+{
+    actualMax = -1;
+    actualCurrents.clear();
+
+    zip->open(zipFile);
+    zip->setNumberOfThreads(4);
+    zip->fileExtracted.connect(boost::bind(fileExtractedWithCurrentsSignalHandler, _1, _2, _3));
+    zip->extractAllFilesTo(tempFolder);
+
+    //like serial: max counts the folders too, each file has its own number
+    std::list<std::string> fileNames = zip->getFileNames();
+    std::set<int> expectedCurrents;
+    for(const auto& fileName : fileNames){
+        if(zip->isFile(fileName)){
+            expectedCurrents.insert(static_cast<int>(expectedCurrents.size()) + 1);
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(fileNames.size()), actualMax);
+    CPPUNIT_ASSERT(expectedCurrents == actualCurrents);
+}
+
+unsigned long long actualBytesExtracted = 0;
+unsigned long long actualBytesToExtract = 0;
+bool actualBytesIncreasing = true;
+void extractionProgressSignalHandler(unsigned long long bytesExtracted, unsigned long long bytesToExtract){
+    actualBytesIncreasing = actualBytesIncreasing && bytesExtracted >= actualBytesExtracted;
+    actualBytesExtracted = bytesExtracted;
+    actualBytesToExtract = bytesToExtract;
+}
+
+void UnzipTest::test_signalExtractionProgress()
+{
+    actualBytesExtracted = 0;
+    actualBytesToExtract = 0;
+    actualBytesIncreasing = true;
+
+    zip->open(zipFile);
+    zip->setNumberOfThreads(4);
+    zip->extractionProgress.connect(boost::bind(extractionProgressSignalHandler, _1, _2));
+    zip->extractAllFilesTo(tempFolder);
+
+    unsigned long long expectedBytes = 0;
+    for(const auto& fileName : zip->getFileNames()){
+        expectedBytes += zip->getFileSize(fileName);
+    }
+
+    CPPUNIT_ASSERT(expectedBytes > 0);
+    CPPUNIT_ASSERT_EQUAL(true, actualBytesIncreasing);
+    CPPUNIT_ASSERT_EQUAL(expectedBytes, actualBytesExtracted);
+    CPPUNIT_ASSERT_EQUAL(expectedBytes, actualBytesToExtract);
+
+    //a single file is counted by itself
+    actualBytesExtracted = 0;
+    zip->extractFileTo(fileInsideZip, tempFolder + "/" + fileInsideZip);
+
+    CPPUNIT_ASSERT_EQUAL(zip->getFileSize(fileInsideZip), actualBytesExtracted);
+    CPPUNIT_ASSERT_EQUAL(zip->getFileSize(fileInsideZip), actualBytesToExtract);
+}
+
 } //cppzip
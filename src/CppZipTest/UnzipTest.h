@@ -54,6 +54,10 @@ class UnzipTest : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_openExistingZipFile);
         CPPUNIT_TEST(test_openZipFileWhileAnotherIsAlreadyOpened);
         CPPUNIT_TEST(test_openANonExistingZipFile);
+        CPPUNIT_TEST(test_openExistingZipFile_MemoryMapped);
+        CPPUNIT_TEST(test_openANonExistingZipFile_MemoryMapped);
+        CPPUNIT_TEST(test_openZipInMemory);
+        CPPUNIT_TEST(test_openZipInMemory_WithInvalidData);
 
         CPPUNIT_TEST(test_closeAZipFile);
         CPPUNIT_TEST(test_closeWhenNoZipFileIsOpened);
@@ -73,11 +77,33 @@ class UnzipTest : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_getFileNames);
         CPPUNIT_TEST(test_getFileNamesWithNoZipFileIsOpened);
         CPPUNIT_TEST(test_getFileNamesAfterCloseZipFiled);
+        CPPUNIT_TEST(test_getFileNamesInZipOrder);
 
         CPPUNIT_TEST(test_getFileContent);
         CPPUNIT_TEST(test_getFileContentWithNoZipFileIsOpened);
         CPPUNIT_TEST(test_getFileContentAfterCloseZipFiled);
         CPPUNIT_TEST(test_getFileContentFromANonExistingFile);
+        CPPUNIT_TEST(test_getFileContent_AJpg);
+        CPPUNIT_TEST(test_getFileContentIntoBuffer);
+        CPPUNIT_TEST(test_getFileContentIntoBuffer_WithTooSmallBuffer);
+        CPPUNIT_TEST(test_getFileContent_WithWrongSizeInCentralDirectory);
+        CPPUNIT_TEST(test_getFileSize);
+        CPPUNIT_TEST(test_openFileReader);
+        CPPUNIT_TEST(test_openFileReader_WithANonExistingFile);
+        CPPUNIT_TEST(test_openFileReader_WhileReadingOtherFiles);
+        CPPUNIT_TEST(test_getFileContent_MemoryMapped);
+        CPPUNIT_TEST(test_getFileContent_WithMultipleThreads);
+        CPPUNIT_TEST(test_getFileContent_WithSeveralUnzips);
+        CPPUNIT_TEST(test_getFileContent_AfterACorruptFile);
+        CPPUNIT_TEST(test_readFileContentAt);
+        CPPUNIT_TEST(test_getFileContent_WithOffset);
+        CPPUNIT_TEST(test_getFileContent_WithOffset_FromPasswordProtectedZipFile);
+        CPPUNIT_TEST(test_saveAndLoadCheckpointIndex);
+        CPPUNIT_TEST(test_getStoredFileRange);
+        CPPUNIT_TEST(test_getRawFileContent);
+        CPPUNIT_TEST(test_getRawFileContent_FromPasswordProtectedZipFile);
+        CPPUNIT_TEST(test_getFileContentFromPasswordProtectedZipFile_MemoryMapped);
+        CPPUNIT_TEST(test_extractAllFilesTo_MemoryMapped_WithMultipleThreads);
         CPPUNIT_TEST(test_getFileContentFromPasswordProtectedZipFile_linux32bit);
         CPPUNIT_TEST(test_getFileContentFromPasswordProtectedZipFile_linux64bit);
         CPPUNIT_TEST(test_getFileContentFromPasswordProtectedZipFile_win64bit_7zip);
@@ -95,10 +121,21 @@ class UnzipTest : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_extractAllFilesToWithUmlaut);
         CPPUNIT_TEST(test_extractAllFiles_WithOverwriteAExistingFile);
         CPPUNIT_TEST(test_extractAllFiles_WithNotOverwriteAExistingFile);
+        CPPUNIT_TEST(test_extractAllFilesTo_WithMultipleThreads);
+        CPPUNIT_TEST(test_extractAllFilesTo_InZipOrder);
+        CPPUNIT_TEST(test_setNumberOfThreads);
+        CPPUNIT_TEST(test_setIndexMode);
+        CPPUNIT_TEST(test_open_WithLazyIndexMode);
+        CPPUNIT_TEST(test_open_WithIndexFile);
+        CPPUNIT_TEST(test_open_WithIndexFile_WhenZipFileChanged);
+        CPPUNIT_TEST(test_openFileReader_WithIndexFile);
+        CPPUNIT_TEST(test_openFileReader_WithLazyIndexMode);
 
         CPPUNIT_TEST(test_signalFileExtracted);
         CPPUNIT_TEST(test_signalBeforeFileExtracted);
         CPPUNIT_TEST(test_signalBeforeFileExtractedWithChangingFileName);
+        CPPUNIT_TEST(test_signalFileExtracted_WithMultipleThreads);
+        CPPUNIT_TEST(test_signalExtractionProgress);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -111,6 +148,10 @@ public:
     void test_openExistingZipFile();
     void test_openZipFileWhileAnotherIsAlreadyOpened();
     void test_openANonExistingZipFile();
+    void test_openExistingZipFile_MemoryMapped();
+    void test_openANonExistingZipFile_MemoryMapped();
+    void test_openZipInMemory();
+    void test_openZipInMemory_WithInvalidData();
 
     void test_closeAZipFile();
     void test_closeWhenNoZipFileIsOpened();
@@ -128,11 +169,33 @@ public:
     void test_getFileNames();
     void test_getFileNamesWithNoZipFileIsOpened();
     void test_getFileNamesAfterCloseZipFiled();
+    void test_getFileNamesInZipOrder();
 
     void test_getFileContent();
     void test_getFileContentWithNoZipFileIsOpened();
     void test_getFileContentAfterCloseZipFiled();
     void test_getFileContentFromANonExistingFile();
+    void test_getFileContent_AJpg();
+    void test_getFileContentIntoBuffer();
+    void test_getFileContentIntoBuffer_WithTooSmallBuffer();
+    void test_getFileContent_WithWrongSizeInCentralDirectory();
+    void test_getFileSize();
+    void test_openFileReader();
+    void test_openFileReader_WithANonExistingFile();
+    void test_openFileReader_WhileReadingOtherFiles();
+    void test_getFileContent_MemoryMapped();
+    void test_getFileContent_WithMultipleThreads();
+    void test_getFileContent_WithSeveralUnzips();
+    void test_getFileContent_AfterACorruptFile();
+    void test_readFileContentAt();
+    void test_getFileContent_WithOffset();
+    void test_getFileContent_WithOffset_FromPasswordProtectedZipFile();
+    void test_saveAndLoadCheckpointIndex();
+    void test_getStoredFileRange();
+    void test_getRawFileContent();
+    void test_getRawFileContent_FromPasswordProtectedZipFile();
+    void test_getFileContentFromPasswordProtectedZipFile_MemoryMapped();
+    void test_extractAllFilesTo_MemoryMapped_WithMultipleThreads();
     void test_getFileContentFromPasswordProtectedZipFile_linux32bit();
     void test_getFileContentFromPasswordProtectedZipFile_linux64bit();
     void test_getFileContentFromPasswordProtectedZipFile_win64bit_7zip();
@@ -148,13 +211,25 @@ public:
     void test_extractAllFilesToWithUmlaut();
     void test_extractAllFiles_WithOverwriteAExistingFile();
     void test_extractAllFiles_WithNotOverwriteAExistingFile();
+    void test_extractAllFilesTo_WithMultipleThreads();
+    void test_extractAllFilesTo_InZipOrder();
+    void test_setNumberOfThreads();
+    void test_setIndexMode();
+    void test_open_WithLazyIndexMode();
+    void test_open_WithIndexFile();
+    void test_open_WithIndexFile_WhenZipFileChanged();
+    void test_openFileReader_WithIndexFile();
+    void test_openFileReader_WithLazyIndexMode();
 
     void test_signalFileExtracted();
     void test_signalBeforeFileExtracted();
     void test_signalBeforeFileExtractedWithChangingFileName();
+    void test_signalFileExtracted_WithMultipleThreads();
+    void test_signalExtractionProgress();
 
 private:
     void beforeFileExtractedSignalHandler_ChangeFileName(std::string& fileName);
+    std::string readWithFileReader(const std::string& fileName);
 
 private:
     std::shared_ptr<Unzip> zip;
@@ -163,6 +238,11 @@ private:
     std::string zipFile;
     std::string zipFileWithUmlaut;
     std::string anotherZipFile;
+    std::string zipFileWithUnorderedCentralDirectory;
+    std::string zipFileWithStoredFiles;
+    std::string zipFileWithWrongSizes;
+    std::string zipFileWithMultipleFiles;
+    std::string zipFileWithACorruptFile;
     std::string notExistingZipFile;
     std::string passwordProtectedZipFile_linux32bit;
     std::string passwordProtectedZipFile_linux64bit;
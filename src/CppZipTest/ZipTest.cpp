@@ -7,12 +7,16 @@
 
 #include "ZipTest.h"
 #include <Zip.h>
+#include <ZipFileWriter.h>
+#include <ZipTransaction.h>
 #include <Unzip.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <list>
 #include <string>
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <boost/foreach.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/bind.hpp>
@@ -30,6 +34,7 @@ void ZipTest::setUp() {
     anotherZipFile = testZipsFolder + "/" + "another_test.zip";
     notExistingZipFile = testZipsFolder + "/" + "not_existing_file.zip";
     writeProtectedZipFile = testZipsFolder + "/" + "write_protected_file.zip";
+    passwordProtectedZipFile = testZipsFolder + "/" + "passwordProtected_linux_64bit.zip";
     tempFolder = "temp";
     picsFolder = "pics";
     fileInsideZipWithUmlaut = "TestFile_ümlaut.txt";
@@ -719,6 +724,226 @@ void ZipTest::test_deleteFile_CheckOtherFileContent() {
             boost::algorithm::starts_with(fileContent, "Lorem ipsum dolor"));
 }
 
+void ZipTest::test_deleteFile_ThenAddAnExistingFile() {
+    std::string zipFileName = tempFolder + "/" + zipFile;
+    std::vector<unsigned char> content(10, 'a');
+
+    createFolder(zipFileName);
+    zip->open(zipFileName);
+    zip->addFile("file1.txt", content);
+    zip->addFile("file2.txt", content);
+    zip->deleteFile("file1.txt");
+
+    //the zip knows its files after the delete
+    bool actual = zip->addFile("file2.txt", content);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("opened", true, zip->isOpened());
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 1, numFilesInZip(zipFileName));
+}
+
+void ZipTest::test_fastDeleteFile() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+    uintmax_t sizeBefore = boost::filesystem::file_size(zipFileName);
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    std::string fileToDelete = folderNameInsideZip + "/file1.txt";
+    bool actual = zip->fastDeleteFile(fileToDelete);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("opened", true, zip->isOpened());
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 7, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", false, containsFile(zipFileName, fileToDelete));
+
+    //only the central directory is shorter, the content stays as hole
+    uintmax_t sizeAfter = boost::filesystem::file_size(zipFileName);
+    CPPUNIT_ASSERT(sizeAfter < sizeBefore);
+    CPPUNIT_ASSERT(sizeAfter > sizeBefore - 100);
+
+    std::string fileContent = getFileContentAsString(zipFileName, folderNameInsideZip + "/file2.txt", "");
+    CPPUNIT_ASSERT_MESSAGE("FileContent begin",
+            boost::algorithm::starts_with(fileContent, "Lorem ipsum dolor"));
+}
+
+void ZipTest::test_fastDeleteFile_ThenAddFile() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+    std::string aString("this is a string");
+    std::vector<unsigned char> content(aString.begin(), aString.end());
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    zip->fastDeleteFile(folderNameInsideZip + "/file2.txt");
+    bool actual = zip->addFile("new.txt", content);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 8, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", aString, getFileContentAsString(zipFileName, "new.txt"));
+}
+
+void ZipTest::test_fastDeleteFile_InMemory() {
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> content(100, 'a');
+
+    zip->open(buffer);
+    zip->addFile("file1.txt", content);
+    zip->addFile("file2.txt", content);
+    zip->close();
+
+    zip->open(buffer, OpenFlags::OpenExisting);
+    bool actual = zip->fastDeleteFile("file1.txt");
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+
+    Unzip unzip;
+    unzip.open(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_EQUAL(1, unzip.getNumFiles());
+    CPPUNIT_ASSERT(content == unzip.getFileContent("file2.txt"));
+}
+
+void ZipTest::test_fastDeleteFiles_InMemory_WithManyFiles() {
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> content(10, 'a');
+    std::list<std::string> fileNames;
+    std::list<std::string> fileNamesToDelete;
+
+    zip->open(buffer);
+    for(int i = 0; i < 1000; ++i){
+        std::string fileName = "folder/file" + std::to_string(i) + ".txt";
+        zip->addFile(fileName, content);
+
+        if(i % 2 == 0){
+            fileNamesToDelete.push_back(fileName);
+        } else {
+            fileNames.push_back(fileName);
+        }
+    }
+    zip->close();
+
+    zip->open(buffer, OpenFlags::OpenExisting);
+    bool actual = zip->fastDeleteFiles(fileNamesToDelete);
+
+    //the zip knows which files are deleted
+    bool deletedFileAdded = zip->addFile(fileNamesToDelete.front(), content);
+    bool existingFileAdded = zip->addFile(fileNames.front(), content);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL(true, deletedFileAdded);
+    CPPUNIT_ASSERT_EQUAL(false, existingFileAdded);
+
+    //the files are listed in the order inside the zip
+    fileNames.push_back(fileNamesToDelete.front());
+
+    Unzip unzip;
+    unzip.open(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT(fileNames == unzip.getFileNames());
+}
+
+void ZipTest::test_addFiles_WithChangingCompressionLevels() {
+    std::string dataDir = "data/test/";
+    std::list<std::string> fileNames;
+    fileNames.push_back(dataDir + fileInsideZip);
+    fileNames.push_back(dataDir + picsFolder + "/" + fileInsideZipJpg);
+
+    std::ifstream ifs((dataDir + picsFolder + "/" + fileInsideZipJpg).c_str(), std::ios::in | std::ios::binary);
+    std::vector<unsigned char> jpgContent((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    //the pooled deflate states of the worker threads are switched between the levels
+    for(int i = 0; i < 20; ++i){
+        std::vector<unsigned char> buffer;
+
+        zip->setNumberOfThreads(4);
+        CPPUNIT_ASSERT(zip->setCompressionLevel(i % 10));
+        zip->open(buffer);
+        CPPUNIT_ASSERT(zip->addFiles(fileNames, false));
+        zip->close();
+
+        Unzip unzip;
+        unzip.open(buffer.data(), buffer.size());
+        std::vector<unsigned char> content = unzip.getFileContent(fileInsideZip);
+        CPPUNIT_ASSERT_EQUAL(std::string("this is a string"), std::string(content.begin(), content.end()));
+        CPPUNIT_ASSERT(jpgContent == unzip.getFileContent(fileInsideZipJpg));
+    }
+}
+
+void ZipTest::test_compact() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    zip->fastDeleteFile(folderNameInsideZip + "/file2.txt");
+    uintmax_t sizeWithHole = boost::filesystem::file_size(zipFileName);
+
+    bool actual = zip->compact();
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT(boost::filesystem::file_size(zipFileName) < sizeWithHole);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 7, numFilesInZip(zipFileName));
+
+    std::string fileContent = getFileContentAsString(zipFileName, folderNameInsideZip + "/file1.txt", "");
+    CPPUNIT_ASSERT_MESSAGE("FileContent begin",
+            boost::algorithm::starts_with(fileContent, "Lorem ipsum dolor"));
+}
+
+void ZipTest::test_compact_KeepsTheFilesAsTheyAre() {
+    std::string zipFileName = tempFolder + "/" + zipFile;
+    std::string compactedZipFileName = tempFolder + "/compacted.zip";
+    std::string aString("this is a string");
+    std::vector<unsigned char> content(aString.begin(), aString.end());
+
+    createFolder(zipFileName);
+    zip->open(zipFileName);
+    zip->addFile("file.txt", content);
+    zip->addEmptyFolder("folder");
+    zip->addFile(readMeFileName);
+    zip->close();
+    copyFile(zipFileName, compactedZipFileName);
+
+    //the files are copied raw, with their times, attributes and flags
+    zip->open(compactedZipFileName, OpenFlags::OpenExisting);
+    bool actual = zip->compact();
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+
+    std::ifstream original(zipFileName, std::ios::binary);
+    std::ifstream compacted(compactedZipFileName, std::ios::binary);
+    std::string originalBytes((std::istreambuf_iterator<char>(original)), std::istreambuf_iterator<char>());
+    std::string compactedBytes((std::istreambuf_iterator<char>(compacted)), std::istreambuf_iterator<char>());
+    CPPUNIT_ASSERT_MESSAGE("same bytes", originalBytes == compactedBytes);
+}
+
+void ZipTest::test_deleteFile_KeepsEncryptedFiles() {
+    std::string zipFileName = tempFolder + "/" + passwordProtectedZipFile;
+    std::vector<unsigned char> content(10, 'a');
+
+    createFolder(zipFileName);
+    copyFile(passwordProtectedZipFile, zipFileName);
+
+    //the encrypted file is copied without knowing the password
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    zip->addFile(anotherFileName, content);
+    bool actual = zip->deleteFile(anotherFileName);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 1, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", std::string("this is a string"),
+                                 getFileContentAsString(zipFileName, fileInsideZip, "secret"));
+}
+
 void ZipTest::test_replaceFile() {
     bool expected = true;
     std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
@@ -794,6 +1019,106 @@ void ZipTest::test_replaceFile_Content() {
     CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, fileToReplace));
 }
 
+void ZipTest::test_commit() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+    std::string aString("this is a string");
+    std::vector<unsigned char> content(aString.begin(), aString.end());
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    ZipTransaction transaction;
+    transaction.replaceFile(folderNameInsideZip + "/file1.txt", content);
+    transaction.replaceFile(readMeFileName, folderNameInsideZip + "/file2.txt");
+    transaction.deleteFolder(folderNameInsideZip + "/folder1");
+    transaction.deleteFile(notExistingFileName);
+    transaction.addFile("new.txt", content);
+    transaction.addFile(readMeFileName, "ReadMe");
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    bool actual = zip->commit(transaction);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 7, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", false, containsFile(zipFileName, folderNameInsideZip + "/folder1/"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, folderNameInsideZip + "/folder2/file2_1.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, "ReadMe"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", aString,
+                                 getFileContentAsString(zipFileName, folderNameInsideZip + "/file1.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", aString, getFileContentAsString(zipFileName, "new.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", getFileContentAsString(zipFileName, "ReadMe"),
+                                 getFileContentAsString(zipFileName, folderNameInsideZip + "/file2.txt"));
+}
+
+void ZipTest::test_commit_OnlyAddFiles() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+    std::string aString("this is a string");
+    std::vector<unsigned char> content(aString.begin(), aString.end());
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    ZipTransaction transaction;
+    transaction.addFile("new.txt", content);
+    transaction.replaceFile(readMeFileName, "ReadMe");
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("same name twice", false, transaction.addFile("new.txt", content));
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    bool actual = zip->commit(transaction);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 10, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", aString, getFileContentAsString(zipFileName, "new.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, "ReadMe"));
+}
+
+void ZipTest::test_commit_WhenFileNameAlreadyExists() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+    std::vector<unsigned char> content(10, 'a');
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    ZipTransaction transaction;
+    transaction.deleteFile(folderNameInsideZip + "/file1.txt");
+    transaction.addFile(folderNameInsideZip + "/file2.txt", content);
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    bool actual = zip->commit(transaction);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 8, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, folderNameInsideZip + "/file1.txt"));
+}
+
+void ZipTest::test_commit_WhenFileNotExistsOnFileSystem() {
+    std::string zipFileName = tempFolder + "/" + zipFileFor_deleteAndReplace;
+    std::vector<unsigned char> content(10, 'a');
+
+    createFolder(zipFileName);
+    copyFile(zipFileFor_deleteAndReplace, zipFileName);
+
+    ZipTransaction transaction;
+    transaction.replaceFile(folderNameInsideZip + "/file1.txt", content);
+    transaction.replaceFile(notExistingFileName, folderNameInsideZip + "/file2.txt");
+
+    zip->open(zipFileName, OpenFlags::OpenExisting);
+    bool actual = zip->commit(transaction);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("opened", true, zip->isOpened());
+    zip->close();
+
+    //the old zip is restored
+    CPPUNIT_ASSERT_EQUAL(false, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 8, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, folderNameInsideZip + "/file2.txt"));
+    CPPUNIT_ASSERT_MESSAGE("FileContent begin",
+            boost::algorithm::starts_with(getFileContentAsString(zipFileName, folderNameInsideZip + "/file1.txt"),
+                                          "Lorem ipsum dolor"));
+}
+
 void ZipTest::test_addFile_WithPasswordProtection() {
     bool expected = true;
     zip->open(tempFolder + "/" + zipFile, OpenFlags::CreateAndOverwrite, "secret");
@@ -861,6 +1186,251 @@ void ZipTest::test_addFile_Content_FromAString_WithPasswordProtection() {
     CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", contentAsString, fileContentAsString);
 }
 
+void ZipTest::test_setNumberOfThreads() {
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("default", 1u, zip->getNumberOfThreads());
+
+    bool actual = zip->setNumberOfThreads(4);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("set 4 threads", true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("get 4 threads", 4u, zip->getNumberOfThreads());
+
+    actual = zip->setNumberOfThreads(0);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("set 0 threads", false, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("get threads after set 0", 4u, zip->getNumberOfThreads());
+}
+
+void ZipTest::test_addFile_WithMultipleThreads() {
+    std::string largeFileName = tempFolder + "/" + "largeFile.txt";
+    std::string content = createLargeFile(largeFileName, 1024 * 1024);
+
+    bool expected = true;
+    zip->setNumberOfThreads(4);
+    zip->open(tempFolder + "/" + zipFile);
+    bool actual = zip->addFile(largeFileName, false);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(expected, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(tempFolder + "/" + zipFile, "largeFile.txt"));
+
+    std::string fileContentAsString = getFileContentAsString(tempFolder + "/" + zipFile, "largeFile.txt");
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", content, fileContentAsString);
+}
+
+void ZipTest::test_addFile_WithMultipleThreads_WithPasswordProtection() {
+    std::string largeFileName = tempFolder + "/" + "largeFile.txt";
+    std::string content = createLargeFile(largeFileName, 1024 * 1024);
+
+    bool expected = true;
+    zip->setNumberOfThreads(4);
+    zip->open(tempFolder + "/" + zipFile, OpenFlags::CreateAndOverwrite, "secret");
+    bool actual = zip->addFile(largeFileName, false);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(expected, actual);
+
+    std::string fileContentAsString = getFileContentAsString(tempFolder + "/" + zipFile, "largeFile.txt", "secret");
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", content, fileContentAsString);
+}
+
+void ZipTest::test_addFiles_WithMultipleThreads() {
+    bool expected = true;
+    std::string zipFileName = tempFolder + "/" + zipFile;
+
+    zip->setNumberOfThreads(4);
+    zip->open(zipFileName);
+    std::string dataDir = "data/test/";
+    std::list<std::string> fileNames;
+    fileNames.push_back(dataDir + fileInsideZip);
+    fileNames.push_back(dataDir + fileInsideZipWithUmlaut);
+    fileNames.push_back(dataDir + picsFolder + "/" + fileInsideZipJpg);
+
+    bool actual = zip->addFiles(fileNames, false);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add", expected, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 3, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, fileInsideZip));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, fileInsideZipWithUmlaut));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, fileInsideZipJpg));
+
+    std::string fileContentAsString = getFileContentAsString(zipFileName, fileInsideZip);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", std::string("this is a string"), fileContentAsString);
+}
+
+void ZipTest::test_addFiles_WithMultipleThreads_WhenOneFileNotExists() {
+    bool expected = false;
+    std::string zipFileName = tempFolder + "/" + zipFile;
+
+    zip->setNumberOfThreads(4);
+    zip->open(zipFileName);
+    std::string dataDir = "data/test/";
+    std::list<std::string> fileNames;
+    fileNames.push_back(dataDir + fileInsideZip);
+    fileNames.push_back(dataDir + notExistingFileName);
+    fileNames.push_back(dataDir + fileInsideZipWithUmlaut);
+
+    bool actual = zip->addFiles(fileNames);
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add", expected, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 2, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, dataDir + fileInsideZip));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, dataDir + fileInsideZipWithUmlaut));
+}
+
+void ZipTest::test_addFolder_WithMultipleThreads() {
+    bool expected = true;
+    std::string zipFileName = tempFolder + "/" + zipFile;
+    std::string serialZipFileName = tempFolder + "/" + anotherZipFile;
+
+    zip->open(serialZipFileName);
+    zip->addFolder("data/test");
+    zip->close();
+
+    zip->setNumberOfThreads(4);
+    zip->open(zipFileName);
+    bool actual = zip->addFolder("data/test");
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(expected, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("count", 7, numFilesInZip(zipFileName));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFolder(zipFileName, "data/test/info"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, "data/test/info/readme.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("contains", true, containsFile(zipFileName, "data/test/pics/matrix.jpg"));
+
+    //the same bytes as with one thread
+    std::string serialZip = readFile(serialZipFileName);
+    CPPUNIT_ASSERT(! serialZip.empty());
+    CPPUNIT_ASSERT_MESSAGE("zip content", serialZip == readFile(zipFileName));
+}
+
+void ZipTest::test_openFileWriter() {
+    std::string zipFileName = tempFolder + "/" + zipFile;
+    std::string line = "this is a line of a generated report\n";
+    std::string expectedContent;
+
+    zip->open(zipFileName);
+    std::shared_ptr<ZipFileWriter> writer = zip->openFileWriter("report.txt");
+    CPPUNIT_ASSERT(writer);
+
+    for(int i = 0; i < 10000; ++i){
+        bool ok = writer->write(reinterpret_cast<const unsigned char*>(line.data()), line.size());
+        CPPUNIT_ASSERT_EQUAL(true, ok);
+        expectedContent += line;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(expectedContent.size()), writer->getBytesWritten());
+    CPPUNIT_ASSERT_EQUAL(true, writer->close());
+    CPPUNIT_ASSERT_EQUAL(false, writer->isOpened());
+    zip->close();
+
+    std::string fileContentAsString = getFileContentAsString(zipFileName, "report.txt");
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("file content", expectedContent, fileContentAsString);
+}
+
+void ZipTest::test_openFileWriter_WhenFileAlreadyExists() {
+    std::vector<unsigned char> content(10, 'a');
+
+    zip->open(tempFolder + "/" + zipFile);
+    zip->addFile("report.txt", content);
+
+    std::shared_ptr<ZipFileWriter> writer = zip->openFileWriter("report.txt");
+    CPPUNIT_ASSERT(! writer);
+}
+
+void ZipTest::test_openFileWriter_WhileAWriterIsOpened() {
+    std::vector<unsigned char> content(10, 'a');
+
+    zip->open(tempFolder + "/" + zipFile);
+    std::shared_ptr<ZipFileWriter> writer = zip->openFileWriter("report.txt");
+    CPPUNIT_ASSERT(writer);
+
+    CPPUNIT_ASSERT(! zip->openFileWriter("another_report.txt"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add while writer is opened", false, zip->addFile("file.txt", content));
+
+    writer->close();
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add after writer is closed", true, zip->addFile("file.txt", content));
+}
+
+void ZipTest::test_openFileWriter_CloseZipClosesTheWriter() {
+    std::string zipFileName = tempFolder + "/" + zipFile;
+    std::vector<unsigned char> content(1000, 'a');
+
+    zip->open(zipFileName);
+    std::shared_ptr<ZipFileWriter> writer = zip->openFileWriter("report.txt");
+    writer->write(content);
+
+    CPPUNIT_ASSERT_EQUAL(true, zip->close());
+    CPPUNIT_ASSERT_EQUAL(false, writer->isOpened());
+    CPPUNIT_ASSERT_EQUAL(false, writer->write(content));
+
+    std::vector<unsigned char> actual = getFileContent(zipFileName, "report.txt");
+    CPPUNIT_ASSERT(content == actual);
+}
+
+void ZipTest::test_openInMemory() {
+    std::vector<unsigned char> buffer;
+    std::string aString("this is a string");
+    std::vector<unsigned char> content(aString.begin(), aString.end());
+
+    bool actual = zip->open(buffer);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("open", true, actual);
+
+    zip->addFile("file.txt", content);
+    zip->addEmptyFolder("folder");
+    zip->close();
+
+    CPPUNIT_ASSERT(! buffer.empty());
+    CPPUNIT_ASSERT(! boost::filesystem::exists("file.txt"));
+
+    Unzip unzip;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("unzip open", true, unzip.open(buffer.data(), buffer.size()));
+    CPPUNIT_ASSERT_EQUAL(2, unzip.getNumFiles());
+    CPPUNIT_ASSERT(content == unzip.getFileContent("file.txt"));
+}
+
+void ZipTest::test_openInMemory_OpenExisting_AddFile() {
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> content(100, 'a');
+
+    zip->open(buffer);
+    zip->addFile("file1.txt", content);
+    zip->close();
+
+    bool actual = zip->open(buffer, OpenFlags::OpenExisting);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("open existing", true, actual);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add existing", false, zip->addFile("file1.txt", content));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("add", true, zip->addFile("file2.txt", content));
+    zip->close();
+
+    Unzip unzip;
+    unzip.open(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_EQUAL(2, unzip.getNumFiles());
+    CPPUNIT_ASSERT(content == unzip.getFileContent("file1.txt"));
+    CPPUNIT_ASSERT(content == unzip.getFileContent("file2.txt"));
+}
+
+void ZipTest::test_openInMemory_DeleteFile() {
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> content(100, 'a');
+
+    zip->open(buffer);
+    zip->addFile("file1.txt", content);
+    zip->addFile("file2.txt", content);
+    zip->close();
+
+    zip->open(buffer, OpenFlags::OpenExisting);
+    bool actual = zip->deleteFile("file1.txt");
+    zip->close();
+
+    CPPUNIT_ASSERT_EQUAL(true, actual);
+
+    Unzip unzip;
+    unzip.open(buffer.data(), buffer.size());
+    CPPUNIT_ASSERT_EQUAL(1, unzip.getNumFiles());
+    CPPUNIT_ASSERT_EQUAL(false, unzip.containsFile("file1.txt"));
+    CPPUNIT_ASSERT(content == unzip.getFileContent("file2.txt"));
+}
+
 bool ZipTest::containsFile(const std::string& zipFileName, const std::string& fileName) {
     Unzip unzip;
 
@@ -925,6 +1495,29 @@ void ZipTest::createFile(const std::string& fileName, const std::string& content
     fileStream << content;
 }
 
+std::string ZipTest::createLargeFile(const std::string& fileName, size_t size)
+{
+    std::string content;
+    content.reserve(size);
+
+    //some compressible, but not too repetitive content
+    for(unsigned int i = 0; content.size() < size; ++i){
+        content += "line " + std::to_string(i) + ": " + std::to_string((i * 7919u) % 10007u) + "\n";
+    }
+    content.resize(size);
+
+    createFolder(fileName);
+    createFile(fileName, content);
+
+    return content;
+}
+
+std::string ZipTest::readFile(const std::string& fileName)
+{
+    std::ifstream fileStream(fileName, std::ios::in | std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>());
+}
+
 void ZipTest::copyFile(const std::string& src, const std::string& dest) {
     //workaround, because boost::filesystem::copy_file don't link
     //because there are some missing symbols...
@@ -98,15 +98,46 @@ class ZipTest : public CppUnit::TestFixture {
         CPPUNIT_TEST(test_deleteFile_WhenFileNotExists);
         CPPUNIT_TEST(test_deleteFile_WhenTemparyFileCouldntCreated);
         CPPUNIT_TEST(test_deleteFile_CheckOtherFileContent);
+        CPPUNIT_TEST(test_deleteFile_ThenAddAnExistingFile);
+        CPPUNIT_TEST(test_deleteFile_KeepsEncryptedFiles);
+
+        CPPUNIT_TEST(test_fastDeleteFile);
+        CPPUNIT_TEST(test_fastDeleteFile_ThenAddFile);
+        CPPUNIT_TEST(test_fastDeleteFile_InMemory);
+        CPPUNIT_TEST(test_fastDeleteFiles_InMemory_WithManyFiles);
+        CPPUNIT_TEST(test_compact);
+        CPPUNIT_TEST(test_compact_KeepsTheFilesAsTheyAre);
 
         CPPUNIT_TEST(test_replaceFile);
         CPPUNIT_TEST(test_replaceFile_WhenFileNotExistsInZip);
         CPPUNIT_TEST(test_replaceFile_WhenFileNotExistsOnFileSystem);
         CPPUNIT_TEST(test_replaceFile_Content);
 
+        CPPUNIT_TEST(test_commit);
+        CPPUNIT_TEST(test_commit_OnlyAddFiles);
+        CPPUNIT_TEST(test_commit_WhenFileNameAlreadyExists);
+        CPPUNIT_TEST(test_commit_WhenFileNotExistsOnFileSystem);
+
         CPPUNIT_TEST(test_addFile_WithPasswordProtection);
         CPPUNIT_TEST(test_addFile_Content_WithPasswordProtection);
         CPPUNIT_TEST(test_addFile_Content_FromAString_WithPasswordProtection);
+
+        CPPUNIT_TEST(test_setNumberOfThreads);
+        CPPUNIT_TEST(test_addFile_WithMultipleThreads);
+        CPPUNIT_TEST(test_addFile_WithMultipleThreads_WithPasswordProtection);
+        CPPUNIT_TEST(test_addFiles_WithMultipleThreads);
+        CPPUNIT_TEST(test_addFiles_WithMultipleThreads_WhenOneFileNotExists);
+        CPPUNIT_TEST(test_addFolder_WithMultipleThreads);
+        CPPUNIT_TEST(test_addFiles_WithChangingCompressionLevels);
+
+        CPPUNIT_TEST(test_openFileWriter);
+        CPPUNIT_TEST(test_openFileWriter_WhenFileAlreadyExists);
+        CPPUNIT_TEST(test_openFileWriter_WhileAWriterIsOpened);
+        CPPUNIT_TEST(test_openFileWriter_CloseZipClosesTheWriter);
+
+        CPPUNIT_TEST(test_openInMemory);
+        CPPUNIT_TEST(test_openInMemory_OpenExisting_AddFile);
+        CPPUNIT_TEST(test_openInMemory_DeleteFile);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -163,22 +194,55 @@ public:
     void test_deleteFile_WhenFileNotExists();
     void test_deleteFile_WhenTemparyFileCouldntCreated();
     void test_deleteFile_CheckOtherFileContent();
+    void test_deleteFile_ThenAddAnExistingFile();
+    void test_deleteFile_KeepsEncryptedFiles();
+
+    void test_fastDeleteFile();
+    void test_fastDeleteFile_ThenAddFile();
+    void test_fastDeleteFile_InMemory();
+    void test_fastDeleteFiles_InMemory_WithManyFiles();
+    void test_compact();
+    void test_compact_KeepsTheFilesAsTheyAre();
 
     void test_replaceFile();
     void test_replaceFile_WhenFileNotExistsInZip();
     void test_replaceFile_WhenFileNotExistsOnFileSystem();
     void test_replaceFile_Content();
 
+    void test_commit();
+    void test_commit_OnlyAddFiles();
+    void test_commit_WhenFileNameAlreadyExists();
+    void test_commit_WhenFileNotExistsOnFileSystem();
+
     void test_addFile_WithPasswordProtection();
     void test_addFile_Content_WithPasswordProtection();
     void test_addFile_Content_FromAString_WithPasswordProtection();
 
+    void test_setNumberOfThreads();
+    void test_addFile_WithMultipleThreads();
+    void test_addFile_WithMultipleThreads_WithPasswordProtection();
+    void test_addFiles_WithMultipleThreads();
+    void test_addFiles_WithMultipleThreads_WhenOneFileNotExists();
+    void test_addFolder_WithMultipleThreads();
+    void test_addFiles_WithChangingCompressionLevels();
+
+    void test_openFileWriter();
+    void test_openFileWriter_WhenFileAlreadyExists();
+    void test_openFileWriter_WhileAWriterIsOpened();
+    void test_openFileWriter_CloseZipClosesTheWriter();
+
+    void test_openInMemory();
+    void test_openInMemory_OpenExisting_AddFile();
+    void test_openInMemory_DeleteFile();
+
 private:
     bool containsFile(const std::string& zipFileName, const std::string& fileName);
     bool containsFolder(const std::string& zipFileName, const std::string& folderName);
     int numFilesInZip(const std::string& zipFileName);
     void createFolder(const std::string& fileName);
     void createFile(const std::string& fileName, const std::string& content);
+    std::string createLargeFile(const std::string& fileName, size_t size);
+    std::string readFile(const std::string& fileName);
     void copyFile(const std::string& src, const std::string& dest);
     std::vector<unsigned char> getFileContent(const std::string& zipFile, const std::string& fileName, const std::string& password = "");
     std::string getFileContentAsString(const std::string& zipFile, const std::string& fileName, const std::string& password = "");
@@ -192,6 +256,7 @@ private:
     std::string anotherZipFile;
     std::string notExistingZipFile;
     std::string writeProtectedZipFile;
+    std::string passwordProtectedZipFile;
     std::string tempFolder;
     std::string picsFolder;
     std::string fileInsideZip;
@@ -322,6 +322,15 @@ extern ZPOS64_T ZEXPORT unzGetCurrentFileZStreamPos64 OF((unzFile file));
 
 /** Addition for GDAL : END */
 
+/** Addition for CppZip : START */
+
+extern int ZEXPORT unzGetCurrentFileLocalHeaderPos64 OF((unzFile file, ZPOS64_T* pos));
+/* Get the position of the local header of the current file in the zip file,
+   incl. the bytes in front of the zip (e.g. of a sfx).
+   return UNZ_OK if there is no problem */
+
+/** Addition for CppZip : END */
+
 
 /***************************************************************************/
 /* for reading the content of the current zipfile, you can open it, read data
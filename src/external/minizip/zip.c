@@ -105,6 +105,7 @@ const char zip_copyright[] =" zip 1.01 Copyright 1998-2004 Gilles Vollant - http
 #define ENDHEADERMAGIC      (0x06054b50)
 #define ZIP64ENDHEADERMAGIC      (0x6064b50)
 #define ZIP64ENDLOCHEADERMAGIC   (0x7064b50)
+#define DATADESCRIPTORMAGIC      (0x08074b50)
 
 #define FLAG_LOCALHEADER_OFFSET (0x06)
 #define CRC_LOCALHEADER_OFFSET  (0x0e)
@@ -1075,11 +1076,12 @@ extern int ZEXPORT zipOpenNewFileInZip4_64 (zipFile file, const char* filename,
     if (file == NULL)
         return ZIP_PARAMERROR;
 
+    /* raw data is written as it is, so every method is possible */
 #ifdef HAVE_BZIP2
-    if ((method!=0) && (method!=Z_DEFLATED) && (method!=Z_BZIP2ED))
+    if ((method!=0) && (method!=Z_DEFLATED) && (method!=Z_BZIP2ED) && (!raw))
       return ZIP_PARAMERROR;
 #else
-    if ((method!=0) && (method!=Z_DEFLATED))
+    if ((method!=0) && (method!=Z_DEFLATED) && (!raw))
       return ZIP_PARAMERROR;
 #endif
 
@@ -1694,6 +1696,23 @@ extern int ZEXPORT zipCloseFileInZipRaw64 (zipFile file, ZPOS64_T uncompressed_s
       zip64local_putValue_inmemory(zi->ci.central_header+30,(uLong)zi->ci.size_centralExtra,2);
     }
 
+    /* the data descriptor, if the caller has set its flag (bit 3) */
+    if ((err==ZIP_OK) && (zi->ci.flag & 8))
+    {
+        int sizeOfSize = zi->ci.zip64 ? 8 : 4;
+
+        err = zip64local_putValue(&zi->z_filefunc,zi->filestream,(uLong)DATADESCRIPTORMAGIC,4);
+
+        if (err==ZIP_OK)
+            err = zip64local_putValue(&zi->z_filefunc,zi->filestream,crc32,4);
+
+        if (err==ZIP_OK)
+            err = zip64local_putValue(&zi->z_filefunc,zi->filestream,compressed_size,sizeOfSize);
+
+        if (err==ZIP_OK)
+            err = zip64local_putValue(&zi->z_filefunc,zi->filestream,uncompressed_size,sizeOfSize);
+    }
+
     if (err==ZIP_OK)
         err = add_data_in_datablock(&zi->central_dir, zi->ci.central_header, (uLong)zi->ci.size_centralheader);
 